@@ -0,0 +1,32 @@
+// --------------------------------------------------
+// Library: a8defb64.h
+// Desc...: Atari 8 Bit Library Base64 definitions
+// Author.: Wade Ripkowski
+// Date...: 2026.11
+// License: GNU General Public License v3.0
+// Note...:
+// Revised: 2026.11.13-Added B64Skip.
+// --------------------------------------------------
+
+#ifndef A8DEFB64_H
+#define A8DEFB64_H
+
+// --------------------------------------------------
+// Definitions
+// --------------------------------------------------
+
+// Decode table values for non Base64 characters
+#define B64BAD 0xFF   // Skipped (whitespace, EOL, etc)
+#define B64PAD 0xFE   // Pad (=), ends decode
+
+// TRUE if character is not Base64 or pad (skipped by decode)
+#define B64Skip(c) (((c) & 0x80) || (cB64Dec[(c)] == B64BAD))
+
+
+// --------------------------------------------------
+// Function Prototypes
+// --------------------------------------------------
+unsigned short B64Enc(unsigned char *cI, unsigned short iS, unsigned char *cO);
+unsigned short B64Dec(unsigned char *cI, unsigned short iS, unsigned char *cO);
+
+#endif
@@ -5,7 +5,14 @@
 // Date...: 2023.02
 // License: GNU General Public License v3.0
 // Note...:
-// Revised:
+// Revised: 2026.10.28-Added FNWriteN.
+//          2026.10.29-Added units, connection table, U functions.
+//          2026.10.31-Added PROCEED data ready service.
+//          2026.11.01-Added FNOpenMU (open mode and translation).
+//          2026.11.02-Added channel mode and JSON functions.
+//          2026.11.10-Added interrupt timer and event callbacks.
+//          2026.11.12-Added handle check (FNBADH, FNEBADH).
+//          2026.11.14-Added FNWaitU.
 // --------------------------------------------------
 
 #ifndef A8DEFFUJI_H
@@ -35,6 +42,9 @@
 #define FNCWRITE 'W'
 #define FNCTIMER 'Z'
 
+// FujiNet Commands - Channel Mode
+#define FNCCHMODE 0xFC
+
 // FujiNet Commands - TCP
 #define FNPACCEPT 'A'
 #define FNPCLOSE  'c'
@@ -47,6 +57,10 @@
 #define FNTRLF   2
 #define FNTRCRLF 3
 
+// FujiNet Channel Modes
+#define FNCHMPROT 0
+#define FNCHMJSON 1
+
 // FujiNet Aux Modes
 #define FNAXREAD    4
 #define FNAXWRITE   8
@@ -61,9 +75,23 @@
 #define FNDSWIFILOST 5
 #define FNDSWIFIDISC 6
 
+// FujiNet Network Units (N1: to N8:)
+#define FNUNITS 8
+
+// TRUE if not a valid connection handle (1 to FNUNITS)
+#define FNBADH(h) ((unsigned char) ((h) - 1) >= FNUNITS)
+
+// Interrupt timer off (FNTimer)
+#define FNTMOFF 0
+
+// PROCEED interrupt vector and PIA port A control
+#define VPRCED 0x0202
+#define PACTL  0xD302
+
 // FujiNet Function Errors/Status
 #define FNSOK     1
 #define FNEDISCO -1
+#define FNEBADH  160   // Invalid handle (unit number error)
 
 // Library Encoding/Decoding parameter support
 #define FNLENCODE  'E'
@@ -83,17 +111,55 @@ typedef struct {
     char version[15];
 } td_fncfg;
 
+// Connection table entry (one per unit)
+typedef struct {
+    unsigned char bO;   // Open
+    unsigned char bC;   // Connected (last FNWaitU/FNCheckU)
+    unsigned char bT;   // Translation mode
+    unsigned char bE;   // Last SIO status
+    unsigned char bX;   // Extended error (last FNWaitU/FNCheckU)
+} td_fncon;
+
+// Connection event callback: handle, # of bytes waiting
+// (FNEDISCO if disconnected)
+typedef void (*td_fnevt)(unsigned char bH, unsigned short iS);
+
+// Open with update mode and no translation
+#define FNOpenU(a,b)  FNOpenMU(a, b, FNAXUPDATE, FNTRNONE)
+
+// Single connection functions use unit 1
+#define FNOpen(a)     (FNOpenU(1, a), FNErrU(1))
+#define FNClose()     FNCloseU(1)
+#define FNCheck()     FNCheckU(1)
+#define FNRead(a,b)   FNReadU(1, a, b)
+#define FNWriteN(a,b) FNWriteNU(1, a, b)
+#define FNWrite(a)    FNWriteU(1, a)
+#define FNTrans(a,b)  FNTransU(1, a, b)
+
 
 // --------------------------------------------------
 // Function Prototypes
 // --------------------------------------------------
 unsigned char FNStatus(void);
-void FNTrans(unsigned char bM, unsigned char bD);
-unsigned char FNOpen(char *cB);
-unsigned char FNClose(void);
-unsigned short FNCheck(void);
-unsigned char FNRead(unsigned short iS, unsigned char *cB);
-unsigned char FNWrite(unsigned char *cB);
+void FNTransU(unsigned char bH, unsigned char bM, unsigned char bD);
+unsigned char FNOpenMU(unsigned char bU, char *cB, unsigned char bM, unsigned char bT);
+unsigned char FNCloseU(unsigned char bH);
+unsigned short FNWaitU(unsigned char bH);
+unsigned short FNCheckU(unsigned char bH);
+unsigned char FNReadU(unsigned char bH, unsigned short iS, unsigned char *cB);
+unsigned char FNWriteNU(unsigned char bH, unsigned char *cB, unsigned short iS);
+unsigned char FNWriteU(unsigned char bH, unsigned char *cB);
+unsigned char FNErrU(unsigned char bH);
+unsigned char FNChanMode(unsigned char bH, unsigned char bM);
+unsigned char FNJsonParse(unsigned char bH);
+unsigned short FNJsonQuery(unsigned char bH, char *cP, unsigned char *cB, unsigned short iM);
+void FNPrcISR(void);
+void FNPrcOn(void);
+void FNPrcOff(void);
+unsigned char FNDataReady(unsigned char bH);
+unsigned char FNTimer(unsigned char bH, unsigned short iM);
+void FNEvtSet(unsigned char bH, td_fnevt pF);
+void FNEvtPoll(void);
 unsigned char FNGConfig(td_fncfg *sC);
 
 #endif
@@ -4,8 +4,13 @@
 // Author.: Wade Ripkowski
 // Date...: 2023.08
 // License: GNU General Public License v3.0
-// Note...:
-// Revised:
+// Note...: -Define B64FNMIN before including the library to
+//           change the size FNB64Auto starts using FujiNet at.
+// Revised: 2026.11.06-Added chunked pipeline (FNB64Begin,
+//                     FNB64Feed, FNB64End).
+//          2026.11.08-Added FNB64Auto.
+//          2026.11.13-B64FNMIN defaults to 0 (always local).
+//                     Added FNB64Put.
 // --------------------------------------------------
 
 #ifndef A8DEFFUJIB64_H
@@ -26,6 +31,31 @@
 #define FNRB64DECLEN 0xCA
 #define FNRB64DECOUT 0xC9
 
+// Smallest input FNB64Auto sends to FujiNet, 0 for never.
+// At 19200 baud each input byte costs about 1.2 ms on the
+// bus (itself plus 4/3 output bytes), more than the local
+// codec (a8libb64.c) takes to convert it, so FujiNet is not
+// faster at any size and the default is never.  With a
+// faster SIO, set it from the fujidemo B64 Bench crossover.
+#ifndef B64FNMIN
+#define B64FNMIN 0
+#endif
+
+// Output callback: buffer and # of bytes in it
+typedef void (*td_b64cb)(unsigned char *cB, unsigned short iS);
+
+// Chunked pipeline state
+typedef struct {
+    char cT;                // Operation type (enc/dec)
+    unsigned char bG;       // Group size (3 enc, 4 dec)
+    unsigned char bC;       // Bytes in carry
+    unsigned char cC[4];    // Carry (partial group)
+    unsigned char bN;       // Input sent since last compute
+    td_b64cb pF;            // Output callback
+    unsigned char *cO;      // Output buffer
+    unsigned short iZ;      // Output buffer size
+} td_b64;
+
 
 // --------------------------------------------------
 // Function Prototypes
@@ -34,5 +64,11 @@ unsigned char FNB64Inp(char cT, char *cB, unsigned short iS);
 unsigned char FNB64Cmp(char cT);
 unsigned char FNB64Len(char cT, unsigned long *iS);
 unsigned char FNB64Out(char cT, char *cB, unsigned short iS);
+void FNB64Begin(td_b64 *pS, char cT, td_b64cb pF, unsigned char *cO, unsigned short iZ);
+unsigned char FNB64Run(td_b64 *pS);
+unsigned char FNB64Put(td_b64 *pS, unsigned char *cB, unsigned short iS);
+unsigned char FNB64Feed(td_b64 *pS, unsigned char *cB, unsigned short iS);
+unsigned char FNB64End(td_b64 *pS);
+unsigned short FNB64Auto(char cT, unsigned char *cI, unsigned short iS, unsigned char *cO);
 
 #endif
@@ -4,8 +4,10 @@
 // Author.: Wade Ripkowski
 // Date...: 2023.08
 // License: GNU General Public License v3.0
-// Note...:
-// Revised:
+// Note...: -Define FNHASHBLK before including the library to
+//           change the FNHashFile read block size.
+// Revised: 2026.11.07-Added FNHashUpdate, FNHashFile.
+//          2026.11.09-Added local only types (a8libhash.c).
 // --------------------------------------------------
 
 #ifndef A8DEFFUJIHASH_H
@@ -28,6 +30,8 @@
 #define FNHASHSHA1 1   // SHA1
 #define FNHASHSHA2 2   // SHA256
 #define FNHASHSHA5 3   // SHA512
+#define FNHASHCRC  4   // CRC32, local only (HashLocal)
+#define FNHASHADL  5   // Adler-32, local only (HashLocal)
 // Output type selection
 #define FNHASHOBIN 0
 #define FNHASHOHEX 1
@@ -36,11 +40,22 @@
 #define FNHASHLENBSHA1 20
 #define FNHASHLENBSHA2 32
 #define FNHASHLENBSHA5 64
+#define FNHASHLENBCRC   4
 // Internal function hex hash sizes
 #define FNHASHLENHMD5   32
 #define FNHASHLENHSHA1  40
 #define FNHASHLENHSHA2  64
 #define FNHASHLENHSHA5 128
+#define FNHASHLENHCRC    8
+// File read block size (FNHashFile), also largest input frame
+#ifndef FNHASHBLK
+#define FNHASHBLK 1024
+#endif
+// FNHashFile could not open or read file
+#define FNHASHEFILE 170
+
+// Progress callback: # of bytes hashed so far
+typedef void (*td_hashcb)(unsigned long lB);
 
 
 // --------------------------------------------------
@@ -49,5 +64,7 @@
 unsigned char FNHashInp(char *cB, unsigned short iS);
 unsigned char FNHashCmp(byte bT);
 unsigned char FNHashOut(byte bT, byte bH, char *cB);
+unsigned char FNHashUpdate(char *cB, unsigned short iS);
+unsigned char FNHashFile(char *pF, byte bT, byte bH, char *cB, td_hashcb pP);
 
 #endif
@@ -0,0 +1,68 @@
+// --------------------------------------------------
+// Library: a8deffujihttp.h
+// Desc...: Atari 8 Bit Library FujiNet HTTP definitions
+// Author.: Wade Ripkowski
+// Date...: 2026.11
+// License: GNU General Public License v3.0
+// Note...: -Define FNHTIME before including the library to
+//           change the default FNHttpBody wait for data.
+// Revised: 2026.11.14-Added FNHttpBody timeout (iFNHTm).
+// --------------------------------------------------
+
+#ifndef A8DEFFUJIHTTP_H
+#define A8DEFFUJIHTTP_H
+
+// --------------------------------------------------
+// Definitions
+// --------------------------------------------------
+
+// HTTP Methods (open aux1)
+#define FNHGET   4
+#define FNHDEL   5
+#define FNHPUT   14
+#define FNHPOST  13
+
+// HTTP Channel Modes (FNPHTTPCH aux2)
+#define FNHMBODY 0
+#define FNHMCOLL 1
+#define FNHMGHDR 2
+#define FNHMSHDR 3
+#define FNHMPOST 4
+
+// FujiNet errors that HTTP results are mapped to
+#define FNHEEOF  136
+#define FNHEDENY 165
+#define FNHENOTF 170
+
+// FNHttpBody gave up waiting for data (SIO timeout code)
+#define FNHETIME 138
+
+// HTTP status codes returned by FNHttpStatus
+#define FNHSOK   200
+#define FNHSDENY 403
+#define FNHSNOTF 404
+#define FNHSFAIL 500
+
+// Default FNHttpBody wait for data (jiffies)
+#ifndef FNHTIME
+#define FNHTIME 600
+#endif
+
+// Body callback: buffer and # of bytes in it
+typedef void (*td_fnhcb)(unsigned char *cB, unsigned short iS);
+
+
+// --------------------------------------------------
+// Function Prototypes
+// --------------------------------------------------
+unsigned char FNHttpOpen(unsigned char bU, unsigned char bM, char *cU);
+unsigned char FNHttpMode(unsigned char bH, unsigned char bM);
+unsigned char FNHttpSetHdr(unsigned char bH, char *cH);
+unsigned char FNHttpCollect(unsigned char bH, char *cN);
+unsigned char FNHttpPost(unsigned char bH, unsigned char *cB, unsigned short iS);
+unsigned short FNHttpGetHdr(unsigned char bH, unsigned char *cB, unsigned short iM);
+unsigned long FNHttpHdrNum(unsigned char *cB, char *cN);
+unsigned short FNHttpStatus(unsigned char bH);
+unsigned long FNHttpBody(unsigned char bH, td_fnhcb pF, unsigned char *cB, unsigned short iZ);
+
+#endif
@@ -0,0 +1,91 @@
+// --------------------------------------------------
+// Library: a8deffujistm.h
+// Desc...: Atari 8 Bit Library FujiNet Stream definitions
+// Author.: Wade Ripkowski
+// Date...: 2026.10
+// License: GNU General Public License v3.0
+// Note...: -Define FNSBUFSZ (power of 2) before including
+//           the library to change the N1: stream buffer size.
+//          -Define FNWBUFSZ before including the library to
+//           change the write buffer size.
+// Revised: 2026.10.28-Added buffered writer.
+//          2026.10.29-Added per handle streams (FNStreamBuf),
+//                     writer handle (FNWSetU).
+//          2026.10.30-Added FNReadLine.
+//          2026.11.12-End of stream on EOF status, FNReadLine
+//                     timeout (iFNRLTm).
+//          2026.11.13-Added FNStm.
+// --------------------------------------------------
+
+#ifndef A8DEFFUJISTM_H
+#define A8DEFFUJISTM_H
+
+// --------------------------------------------------
+// Definitions
+// --------------------------------------------------
+
+// N1: stream ring buffer size (must be power of 2)
+#ifndef FNSBUFSZ
+#define FNSBUFSZ 512
+#endif
+
+// No byte available from FNStreamGetc, end of stream for FNReadLine
+#define FNSEOF -1
+
+// FNReadLine timed out with nothing read
+#define FNSTIME -2
+
+// Extended error (FNCheckU) when all data has been sent
+#define FNSXEOF 136
+
+// Default FNReadLine wait for data (jiffies, 0 = no wait)
+#ifndef FNRLTIME
+#define FNRLTIME 600
+#endif
+
+// Line ends for FNReadLine (untranslated)
+#define FNSLF 10
+#define FNSCR 13
+
+// Write buffer size
+#ifndef FNWBUFSZ
+#define FNWBUFSZ 256
+#endif
+
+// Stream ring buffer state
+// Bytes are read at head and filled at tail.
+typedef struct {
+    unsigned char *cB;      // Buffer
+    unsigned short iM;      // Buffer size - 1 (index mask)
+    unsigned short iHd;     // Head (read) index
+    unsigned short iTl;     // Tail (fill) index
+    unsigned short iCt;     // Bytes in buffer
+    unsigned char bEn;      // Disconnect or EOF seen
+} td_fnstm;
+
+// Single connection functions use unit 1
+#define FNStreamInit()    FNStreamInitU(1)
+#define FNStreamFill()    FNStreamFillU(1)
+#define FNStreamRead(a,b) FNStreamReadU(1, a, b)
+#define FNStreamGetc()    FNStreamGetcU(1)
+#define FNStreamEnd()     FNStreamEndU(1)
+
+
+// --------------------------------------------------
+// Function Prototypes
+// --------------------------------------------------
+td_fnstm *FNStm(unsigned char bH);
+void FNStreamBuf(unsigned char bH, td_fnstm *pS, unsigned char *cB, unsigned short iZ);
+void FNStreamInitU(unsigned char bH);
+unsigned short FNStreamFillU(unsigned char bH);
+unsigned short FNStreamReadU(unsigned char bH, unsigned char *cB, unsigned short iM);
+int FNStreamGetcU(unsigned char bH);
+unsigned char FNStreamEndU(unsigned char bH);
+int FNReadLine(unsigned char bH, unsigned char *cB, unsigned short iM);
+void FNWSetU(unsigned char bH);
+unsigned char FNWFlush(void);
+unsigned char FNWPut(unsigned char *cB, unsigned short iS);
+unsigned char FNWStr(unsigned char *cB);
+unsigned char FNWChr(unsigned char bC);
+
+#endif
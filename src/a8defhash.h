@@ -0,0 +1,54 @@
+// --------------------------------------------------
+// Library: a8defhash.h
+// Desc...: Atari 8 Bit Library Hash definitions
+// Author.: Wade Ripkowski
+// Date...: 2026.11
+// License: GNU General Public License v3.0
+// Note...: Requires: a8deffujihash.h (hash type constants)
+// Revised:
+// --------------------------------------------------
+
+#ifndef A8DEFHASH_H
+#define A8DEFHASH_H
+
+// --------------------------------------------------
+// Definitions
+// --------------------------------------------------
+
+// Starting values for running CRC32 and Adler-32
+#define HASHCRCINI 0
+#define HASHADLINI 1
+
+// Adler-32 modulus, and most bytes before sums must be reduced
+#define HASHADLMOD 65521
+#define HASHADLMAX 5552
+
+// 32 bit rotate left
+#define HASHROL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+
+// --------------------------------------------------
+// Types
+// --------------------------------------------------
+
+// SHA-1 state
+typedef struct {
+    unsigned long lH[5];    // Hash
+    unsigned long lN;       // Bytes hashed
+    unsigned char cW[64];   // Block
+    unsigned char bN;       // Bytes in block
+} td_sha1;
+
+
+// --------------------------------------------------
+// Function Prototypes
+// --------------------------------------------------
+unsigned long HashCRC(unsigned long lC, unsigned char *cB, unsigned short iS);
+unsigned long HashAdl(unsigned long lA, unsigned char *cB, unsigned short iS);
+void HashShaInit(td_sha1 *pS);
+void HashShaBlk(td_sha1 *pS);
+void HashShaAdd(td_sha1 *pS, unsigned char *cB, unsigned short iS);
+void HashShaEnd(td_sha1 *pS, unsigned char *cO);
+unsigned char HashLocal(byte bT, byte bH, unsigned char *cB, unsigned short iS, unsigned char *cO);
+
+#endif
@@ -14,13 +14,16 @@
 //                 -Added GAlertM types
 //                 -Added many XL/XE memory locaation codes
 //          2025.02-Added KSLASH codes
+//          2026.10-Version 1.6.0
+//                 -Added GPULL, XLEFT/XRIGHT
+//                 -Added PADDL0, PTRIG0
 // --------------------------------------------------
 
 #ifndef A8DEFINES_H
 #define A8DEFINES_H
 
 // Version
-#define LIB_VERSION "1.5.1"
+#define LIB_VERSION "1.6.0"
 
 // True & False
 #ifndef TRUE
@@ -60,6 +63,7 @@ typedef unsigned int word;		// 16 bits / 2 BYTEs
 #define GEDIT   1
 #define GHORZ   1
 #define GVERT   2
+#define GPULL   3
 #define GCON    1
 #define GCOFF   2
 #define GANY    0
@@ -77,6 +81,8 @@ typedef unsigned int word;		// 16 bits / 2 BYTEs
 #define GAERR   3
 
 // Menu Exits
+#define XLEFT 251
+#define XRIGHT 252
 #define XESC  253
 #define XTAB  254
 #define XNONE 255
@@ -387,7 +393,9 @@ typedef unsigned int word;		// 16 bits / 2 BYTEs
 #define SDMCTL *((byte *) 0x022F)
 #define SDLSTL *((word *) 0x0230)
 #define GPRIOR *((byte *) 0x026F)
+#define PADDL0 *((byte *) 0x0270)
 #define STICK0 *((byte *) 0x0278)
+#define PTRIG0 *((byte *) 0x027C)
 #define STRIG0 *((byte *) 0x0284)
 #define COLOR0 *((byte *) 0x02C4)
 #define COLOR1 *((byte *) 0x02C5)
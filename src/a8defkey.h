@@ -0,0 +1,125 @@
+// --------------------------------------------------
+// Library: a8defkey.h
+// Desc...: Atari 8 Bit Library Keyboard service definitions
+// Author.: Wade Ripkowski
+// Date...: 2026.10
+// License: GNU General Public License v3.0
+// Note...: Requires: a8defines.h
+//          -Define WKEYQ before including the libraries to
+//           have WInit() start the keyboard queue service.
+//          -Define KEYREC before including the libraries to
+//           add keystroke record/replay (requires stdio.h).
+// Revised: 2026.10-Added key repeat acceleration.
+//          2026.10-Added joystick/paddle input and key source.
+//          2026.10-Added keymap layers.
+//          2026.10-Added idle task scheduler.
+//          2026.10-Added keystroke record/replay.
+//          2026.11-Joystick off by default, trigger debounce (KJDEB).
+//          2026.11-KeyJif always available, added KeyPost, key
+//                  records hold key source.
+// --------------------------------------------------
+
+#ifndef A8DEFKEY_H
+#define A8DEFKEY_H
+
+// --------------------------------------------------
+// Definitions
+// --------------------------------------------------
+
+// Key queue size (must be power of 2) and index mask
+#define KQSIZE 32
+#define KQMASK 31
+
+// Key repeat acceleration
+// Held key repeats closer than KRGAP jiffies count up to
+// KRLVL1 (medium steps) and KRLVL2 (fast steps).
+#define KRGAP  12
+#define KRLVL1 6
+#define KRLVL2 18
+#define KRSLOW 0
+#define KRMED  1
+#define KRFAST 2
+
+// Input devices polled with the keyboard (KeyDev)
+#define KDNONE 0
+#define KDJOY  1
+#define KDPAD  2
+
+// Source of last key (bKSrc)
+#define KSKEY 0
+#define KSCON 1
+#define KSHLP 2
+#define KSJOY 3
+#define KSPAD 4
+
+// Joystick first repeat delay and repeat rate (jiffies),
+// trigger debounce (jiffies released), paddle movement per step
+#define KJDLY  20
+#define KJRPT  5
+#define KJDEB  3
+#define KPSTEP 8
+
+// Keymap layer flags (KeyLayer)
+#define KLNONE 0
+#define KLSWAP 1
+
+// Idle task slots, and no slot
+#define KISLOTS 4
+#define KINONE  255
+
+// Keystroke record/replay modes
+#define KYOFF  0
+#define KYREC  1
+#define KYPLAY 2
+#define KYPACE 3
+
+// Longest recorded gap between keys (jiffies)
+#define KYGMAX 3600
+
+// OS vectors and routines
+#define VVBLKI 0x0222
+#define SETVBV 0xE45C
+
+
+// --------------------------------------------------
+// Types
+// --------------------------------------------------
+
+// Recorded keystroke: raw keycode, jiffies since previous key,
+// key source (bKSrc)
+typedef struct {
+    word wK;
+    word wT;
+    byte bS;
+} td_keyrec;
+
+
+// --------------------------------------------------
+// Function Prototypes
+// --------------------------------------------------
+void KeyQVBI(void);
+void KeyQOn(void);
+void KeyQOff(void);
+word KeyRaw(void);
+word KeyPost(word cR, byte bI);
+word KeyPoll(byte bI);
+byte KeyPend(void);
+byte KeyRep(word wK);
+void KeyDev(byte bD);
+word KeyJoy(void);
+void KeyLayer(const byte *pL, byte bF);
+byte KIdleAdd(void (*pF)(void), byte bP);
+void KIdleDel(byte bS);
+byte KIdleRun(void);
+word KeyJif(void);
+
+#ifdef KEYREC
+void KeyRec(td_keyrec *pB, word wS);
+void KeyPlay(td_keyrec *pB, word wC, byte bP);
+word KeyStop(void);
+byte KeySave(char *pF);
+word KeyLoad(char *pF, td_keyrec *pB, word wS);
+word KeyNext(void);
+#endif
+
+#endif
@@ -4,8 +4,17 @@
 // Author.: Wade Ripkowski
 // Date...: 2023.07
 // License: GNU General Public License v3.0
-// Note...:
-// Revised:
+// Note...: -Define SIO_STATS before including the libraries
+//           to keep SIO metrics per device/command.
+// Revised: 2026.11.03-Added SIO status codes, call class
+//                     policies, and SIOCall (a8libsio.c).
+//          2026.11.04-Added SIO_STATS transaction metrics.
+//          2026.11.05-Added DCB templates (td_siodcb) and SIOReq.
+//          2026.11.13-Absent table is per device/unit, timed in
+//                     jiffies (SIOABSTM).  Added SIOPDATA class.
+//          2026.11.14-Added SIODevOk, SIOProbe (SIOPRSN, SIOPRCMD).
+//                     SIOJif removed (KeyJif in a8libmisc.c).
+//                     SIOStatsWin moved to fujidemo (ShowSIO).
 // --------------------------------------------------
 
 #ifndef A8DEFSIO_H
@@ -17,5 +26,94 @@
 
 #define SIOV() (asm("JSR $E459"))
 
+// SIO status codes
+#define SIOOK    1
+#define SIOETIME 138
+#define SIOENAK  139
+#define SIOEFRM  140
+#define SIOEOVR  142
+#define SIOECHK  143
+#define SIOEDONE 144
+
+// SIO call classes (index into sSIOPol)
+#define SIOPFAST 0
+#define SIOPNORM 1
+#define SIOPSLOW 2
+#define SIOPPROB 3
+#define SIOPDATA 4
+#define SIOPCNT  5
+
+// Absent device/unit table size, and how long a device
+// unit stays absent (jiffies)
+#define SIOABSN  4
+#define SIOABSTM 240
+
+// Answered device/unit table size, and probe command sent
+// before the first slow call (any answer, even NAK, will do)
+#define SIOPRSN  4
+#define SIOPRCMD 0x53
+
+// DCB template, same layout as OS DCB ($0300).
+// Call class is kept in the unused DCB byte.
+typedef struct {
+    unsigned char bDev;     // Device ID
+    unsigned char bUnit;    // Unit
+    unsigned char bCmd;     // Command
+    unsigned char bStat;    // Direction (DCBREAD, DCBWRITE, DCBNONE)
+    void *pBuf;             // Buffer
+    unsigned char bTim;     // Timeout (set from call class)
+    unsigned char bPol;     // Call class
+    unsigned short iByt;    // Bytes
+    unsigned short iAux;    // Aux1 (low), Aux2 (high)
+} td_siodcb;
+
+// Call class policy
+typedef struct {
+    unsigned char bT;   // DCB timeout (seconds)
+    unsigned char bR;   // Retries after transient error
+    unsigned char bB;   // Backoff before retry (jiffies)
+} td_siopol;
+
+#ifdef SIO_STATS
+// Metrics table size, GTIA PAL flag register
+#define SIOSTN 16
+#define PAL    0xD014
+
+// VCOUNT at the vertical blank, where the jiffy clock ticks
+#define SIOVBL 124
+
+// Metrics per device/command
+// Latency is in VCOUNT units (2 scan lines),
+// bSIOLpf per frame (jiffy).
+typedef struct {
+    unsigned char bD;   // Device ID (0 = free)
+    unsigned char bC;   // Command
+    unsigned short iN;  // Calls
+    unsigned short iE;  // Calls with error status
+    unsigned long lB;   // Bytes moved by good calls
+    unsigned long lT;   // Total latency
+    unsigned short iM;  // Max latency
+} td_siostat;
+#endif
+
+
+// --------------------------------------------------
+// Function Prototypes
+// --------------------------------------------------
+unsigned char SIODevAbs(unsigned char bD, unsigned char bU);
+void SIODevClr(unsigned char bD);
+void SIODevMrk(unsigned char bD, unsigned char bU);
+unsigned char SIODevOk(unsigned char bD, unsigned char bU);
+unsigned char SIOProbe(void);
+unsigned char SIOCall(unsigned char bP);
+unsigned char SIOReq(const td_siodcb *pT, unsigned char bU, void *pB, unsigned short iS, unsigned short iA);
+#ifdef SIO_STATS
+unsigned char SIOVPos(void);
+void SIOStatsAdd(unsigned char bS, unsigned long lT);
+td_siostat *SIOStatsGet(unsigned char *pC);
+void SIOStatsClr(void);
+#endif
+
+
 
 #endif
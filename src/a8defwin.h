@@ -6,7 +6,8 @@
 // Note...: Requires: a8defines.c
 //          -Converted from Action!
 //          -Unsigned char is synonymous with byte (from a8defines.h)
-// Revised:
+// Revised: 2026.10-Added td_mpull pull-down menu descriptor.
+//          2026.10-Added td_view text viewer record.
 
 #ifndef A8DEFWIN_H
 #define A8DEFWIN_H
@@ -37,4 +38,30 @@ td_wnpos vCur;
 unsigned char baWM[WBUFSZ];
 unsigned char *cpWM;
 
+
+// Pull-down menu descriptor (one per menu bar item)
+// cC is optional image cache of (item len + 2) * (item count + 2)
+// bytes, NULL for no cache.  Set bV to FALSE and bS to 1 initially.
+typedef struct {
+    unsigned char bC;       // number of items
+    unsigned char **pS;     // item strings (same length)
+    unsigned char *pK;      // item accelerator keys, NULL for first letter
+    unsigned char *cC;      // cached pull-down image
+    unsigned char bV;       // cache valid flag
+    unsigned char bS;       // last selected item
+} td_mpull;
+
+
+// Text viewer record (see GVInit)
+typedef struct {
+    unsigned char *pB;      // text buffer (ATASCII)
+    unsigned int iS;        // bytes indexed so far
+    unsigned int *pI;       // line start offsets
+    unsigned int iM;        // max line start offsets
+    unsigned int iC;        // line count
+    unsigned int iT;        // top line shown
+    unsigned char bW;       // view width (lines wrap at this)
+    unsigned char bL;       // length of last line so far
+} td_view;
+
 #endif
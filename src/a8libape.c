@@ -6,14 +6,24 @@
 // License: GNU General Public License v3.0
 // Note...: Requires: a8defines.h, a8defape.h, a8libsio.c
 //          Also FujiNet, SIO2PC, or other APETIME provider.
-// Revised:
+// Revised: 2026.11.03-Calls SIO through SIOCall (probe class).
+//          2026.11.05-DCB set from const template (SIOReq).
 // --------------------------------------------------
 
 #include <atari.h>
 #include "a8defines.h"
+#include "a8defsio.h"
 #include "a8defape.h"
 
 
+// --------------------------------------------------
+// DCB templates: device, unit, command, direction, buffer,
+// timeout, call class, bytes, aux.
+// SIOReq patches unit, buffer, bytes, and aux.
+// --------------------------------------------------
+const td_siodcb cApeTTime = { APEDEVID, 1, APEGTIME, DCBREAD, NULL, 0, SIOPPROB, 0, 0 };
+
+
 // -----------------------------------
 // Proc..: void ApeTimeG(char *cB)
 // Desc..: Get date/time via APETIME protocol
@@ -21,20 +31,9 @@
 // -----------------------------------
 void ApeTimeG(char *cB)
 {
-    // Setup DCB
+    // Call SIO
     // APETime=Device 69 ($45), Unit 1
     // Time command=147 ($93)
-    // Get 6 bytes, timeout just over 15s
-    OS.dcb.ddevic = APEDEVID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = APEGTIME;
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = cB;
-    OS.dcb.dbyt   = 6;
-    OS.dcb.daux   = 0;
-    OS.dcb.dtimlo = 15;
-//    OS.dcb.dunuse = 0;
-
-    // Call SIO
-    SIOV();
+    // Get 6 bytes, probe class (fails fast if absent)
+    SIOReq(&cApeTTime, 1, cB, 6, 0);
 }
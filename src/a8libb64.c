@@ -0,0 +1,128 @@
+// --------------------------------------------------
+// Library: a8libb64.c
+// Desc...: Atari 8 Bit Base64 Library
+// Author.: Wade Ripkowski
+// Date...: 2026.11
+// License: GNU General Public License v3.0
+// Note...: -Requires: a8defines.h
+//          -Encodes/decodes locally, no FujiNet needed.
+// Revised:
+// --------------------------------------------------
+
+#include "a8defines.h"
+#include "a8defb64.h"
+
+
+// --------------------------------------------------
+// Globals
+// --------------------------------------------------
+
+// Encode table (6 bit value to character)
+const unsigned char cB64Enc[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Decode table (7 bit character to 6 bit value)
+const unsigned char cB64Dec[128] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+
+// -----------------------------------
+// Proc..: unsigned short B64Enc(unsigned char *cI, unsigned short iS, unsigned char *cO)
+// Desc..: Base64 encodes a buffer
+// Params: cI = input buffer
+//         iS = # of bytes in input
+//         cO = output buffer (must hold ((iS + 2) / 3) * 4 + 1)
+// Return: # of characters in output
+// Note..: Output is padded and zero terminated.
+// -----------------------------------
+unsigned short B64Enc(unsigned char *cI, unsigned short iS, unsigned char *cO)
+{
+    unsigned char *pO = cO;
+    unsigned char b0, b1, b2;
+
+    // Whole groups, 3 bytes to 4 characters
+    while (iS >= 3) {
+        b0 = *(cI++);
+        b1 = *(cI++);
+        b2 = *(cI++);
+        *(pO++) = cB64Enc[b0 >> 2];
+        *(pO++) = cB64Enc[((b0 & 0x03) << 4) | (b1 >> 4)];
+        *(pO++) = cB64Enc[((b1 & 0x0F) << 2) | (b2 >> 6)];
+        *(pO++) = cB64Enc[b2 & 0x3F];
+        iS -= 3;
+    }
+
+    // Last partial group, padded
+    if (iS > 0) {
+        b0 = cI[0];
+        b1 = (iS == 2 ? cI[1] : 0);
+        *(pO++) = cB64Enc[b0 >> 2];
+        *(pO++) = cB64Enc[((b0 & 0x03) << 4) | (b1 >> 4)];
+        *(pO++) = (iS == 2 ? cB64Enc[(b1 & 0x0F) << 2] : '=');
+        *(pO++) = '=';
+    }
+
+    // Terminate
+    *pO = 0;
+
+    return pO - cO;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short B64Dec(unsigned char *cI, unsigned short iS, unsigned char *cO)
+// Desc..: Base64 decodes a buffer
+// Params: cI = input buffer
+//         iS = # of characters in input
+//         cO = output buffer (must hold (iS / 4) * 3 + 1)
+// Return: # of bytes in output
+// Note..: Non Base64 characters are skipped, pad ends the
+//         decode.  Output is zero terminated.
+// -----------------------------------
+unsigned short B64Dec(unsigned char *cI, unsigned short iS, unsigned char *cO)
+{
+    unsigned char *pO = cO;
+    unsigned char bV, bA = 0, bN = 0;
+
+    while (iS > 0) {
+        // Get 6 bit value
+        bV = *(cI++);
+        bV = (bV & 0x80 ? B64BAD : cB64Dec[bV]);
+        iS--;
+
+        // End at pad, skip others
+        if (bV == B64PAD) {
+            break;
+        }
+        if (bV == B64BAD) {
+            continue;
+        }
+
+        // Put 4 values together into 3 bytes
+        switch (bN) {
+            case 0: bA = bV << 2;
+                    break;
+            case 1: *(pO++) = bA | (bV >> 4);
+                    bA = bV << 4;
+                    break;
+            case 2: *(pO++) = bA | (bV >> 2);
+                    bA = bV << 6;
+                    break;
+            case 3: *(pO++) = bA | bV;
+                    break;
+        }
+        bN = (bN + 1) & 0x03;
+    }
+
+    // Terminate
+    *pO = 0;
+
+    return pO - cO;
+}
@@ -6,7 +6,22 @@
 // License: GNU General Public License v3.0
 // Note...: -Requires: a8deffuji.h, a8defines.h, a8libsio.c
 //          -N: does not need to be loaded.
-// Revised:
+// Revised: 2026.10.28-Added FNWriteN, FNWrite uses it.
+//          2026.10.29-Added units N1:-N8: with connection table.
+//                     Connection functions take a handle (U
+//                     versions), old ones are defines for N1:.
+//          2026.10.31-Added PROCEED data ready service (FNPrcOn,
+//                     FNPrcOff, FNDataReady).
+//          2026.11.01-FNOpenU is now a define for FNOpenMU, which
+//                     takes open mode and translation.
+//          2026.11.02-Added FNChanMode, FNJsonParse, FNJsonQuery.
+//          2026.11.03-Calls SIO through SIOCall with call classes.
+//          2026.11.05-DCB set from const templates (SIOReq).
+//          2026.11.10-Added FNTimer, event callbacks (FNEvtSet,
+//                     FNEvtPoll).
+//          2026.11.12-Handle functions check the handle (FNBADH).
+//          2026.11.13-FNJsonQuery rejects a 0 size buffer.
+//          2026.11.14-Added FNWaitU (bytes waiting after close).
 // --------------------------------------------------
 // Portions are derivative works based on nio.c as
 // found in many of the FujiNet application sources
@@ -14,11 +29,51 @@
 // --------------------------------------------------
 
 #include <atari.h>
+#include <stdlib.h>
+#include <peekpoke.h>
 #include "a8defines.h"
 #include "a8deffuji.h"
 #include "a8defsio.h"
 
 
+// --------------------------------------------------
+// DCB templates: device, unit, command, direction, buffer,
+// timeout, call class, bytes, aux.
+// SIOReq patches unit, buffer, bytes, and aux.
+// --------------------------------------------------
+const td_siodcb cFNTStat = { FNRAWID, 1, FNRWFSTAT,  DCBREAD,  NULL, 0, SIOPFAST, 0, 0 };
+const td_siodcb cFNTGCfg = { FNRAWID, 1, FNRGCONFIG, DCBREAD,  NULL, 0, SIOPFAST, 0, 0 };
+const td_siodcb cFNTTran = { FNDEVID, 1, FNCTRAN,    DCBNONE,  NULL, 0, SIOPFAST, 0, 0 };
+const td_siodcb cFNTOpen = { FNDEVID, 1, FNCOPEN,    DCBWRITE, NULL, 0, SIOPSLOW, 0, 0 };
+const td_siodcb cFNTClos = { FNDEVID, 1, FNCCLOSE,   DCBNONE,  NULL, 0, SIOPNORM, 0, 0 };
+const td_siodcb cFNTChk  = { FNDEVID, 1, FNCSTAT,    DCBREAD,  NULL, 0, SIOPFAST, 0, 0 };
+const td_siodcb cFNTRead = { FNDEVID, 1, FNCREAD,    DCBREAD,  NULL, 0, SIOPDATA, 0, 0 };
+const td_siodcb cFNTWrit = { FNDEVID, 1, FNCWRITE,   DCBWRITE, NULL, 0, SIOPDATA, 0, 0 };
+const td_siodcb cFNTChMd = { FNDEVID, 1, FNCCHMODE,  DCBNONE,  NULL, 0, SIOPFAST, 0, 0 };
+const td_siodcb cFNTPars = { FNDEVID, 1, FNCPARSE,   DCBNONE,  NULL, 0, SIOPSLOW, 0, 0 };
+const td_siodcb cFNTQury = { FNDEVID, 1, FNCQUERY,   DCBWRITE, NULL, 0, SIOPNORM, 0, 0 };
+const td_siodcb cFNTTimr = { FNDEVID, 1, FNCTIMER,   DCBNONE,  NULL, 0, SIOPFAST, 0, 0 };
+
+
+// --------------------------------------------------
+// Connection table, one entry per unit (handle - 1)
+// --------------------------------------------------
+td_fncon sFNCon[FNUNITS];
+
+
+// --------------------------------------------------
+// PROCEED data ready service
+// Ready bits are set for all open units on interrupt,
+// as PROCEED does not say which unit has data.
+// --------------------------------------------------
+const unsigned char cFNBit[FNUNITS] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+unsigned char bFNPrc = 0, bFNPrM = 0, bFNPrOn = FALSE;
+unsigned short wFNPrOv;
+
+// Event callbacks, one per unit (FNEvtSet)
+td_fnevt pFNEvt[FNUNITS];
+
+
 // -----------------------------------
 // Proc..: unsigned char FNStatus(void)
 // Desc..: Get FujiNet device wifi status
@@ -34,28 +89,18 @@ unsigned char FNStatus(void)
 {
     unsigned char bS = 0;
 
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNRWFSTAT;
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = &bS;
-    OS.dcb.dbyt   = 1;
-    OS.dcb.daux1  = 0;
-    OS.dcb.daux2  = 0;
-    OS.dcb.dtimlo = 15;
-
     // Call SIO
-    SIOV();
+    SIOReq(&cFNTStat, 1, &bS, 1, 0);
 
     return bS;
 }
 
 
 // -----------------------------------
-// Proc..: void FNTrans(unsigned char bM, unsigned char bD)
+// Proc..: void FNTransU(unsigned char bH, unsigned char bM, unsigned char bD)
 // Desc..: Sets translation mode for EOL
-// Param.: bM = Translation mode
+// Param.: bH = connection handle
+//         bM = Translation mode
 //              FNTRNONE = none
 //              FNTRCR   = CR
 //              FNTRLF   = LF
@@ -67,111 +112,176 @@ unsigned char FNStatus(void)
 // Return: n/a
 // Note..: Must be called AFTER open.
 // -----------------------------------
-void FNTrans(unsigned char bM, unsigned char bD)
+void FNTransU(unsigned char bH, unsigned char bM, unsigned char bD)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNDEVID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNCTRAN;
-    OS.dcb.dstats = DCBNONE;
-    OS.dcb.dbuf   = NULL;
-    OS.dcb.dbyt   = 0;
-    OS.dcb.daux1  = bD;
-    OS.dcb.daux2  = bM;
-    OS.dcb.dtimlo = 15;
+    // Check handle
+    if (FNBADH(bH)) {
+        return;
+    }
 
-    // Call SIO
-    SIOV();
+    // Call SIO (aux1 = direction, aux2 = mode)
+    SIOReq(&cFNTTran, bH, NULL, 0, (bM << 8) | bD);
+
+    // Record mode and status
+    sFNCon[bH - 1].bT = bM;
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
 }
 
 
 // -----------------------------------
-// Proc..: unsigned char FNOpen(char *cB)
-// Desc..: Open connection to URL
-// Params: cB = URL to open (up to 256 bytes)
+// Proc..: unsigned char FNOpenMU(unsigned char bU, char *cB, unsigned char bM, unsigned char bT)
+// Desc..: Open connection to URL on a unit
+// Params: bU = unit (1-8 for N1: to N8:)
+//         cB = URL to open (up to 256 bytes)
 //              N:TCP://addr:port/
-// Notes.: Open with NO translation
-// Return: SIO status (FNSOK = Success)
+//         bM = open mode (aux1), ie FNAXUPDATE
+//         bT = translation mode (aux2), ie FNTRNONE
+// Notes.: SIO status is kept, see FNErrU.
+//         FNOpenU opens with update mode and NO translation.
+// Return: connection handle, 0 on failure
 // -----------------------------------
-unsigned char FNOpen(char *cB)
+unsigned char FNOpenMU(unsigned char bU, char *cB, unsigned char bM, unsigned char bT)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNDEVID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNCOPEN;
-    OS.dcb.dstats = DCBWRITE;
-    OS.dcb.dbuf   = cB;           // (void *)
-    OS.dcb.dbyt   = 256;
-    OS.dcb.daux1  = FNAXUPDATE;
-    OS.dcb.daux2  = FNTRNONE;
-    OS.dcb.dtimlo = 15;
+    td_fncon *pC;
 
-    // Call SIO
-    SIOV();
+    // Check unit
+    if (FNBADH(bU)) {
+        return 0;
+    }
+    pC = &sFNCon[bU - 1];
+
+    // Call SIO (aux1 = mode, aux2 = translation)
+    SIOReq(&cFNTOpen, bU, cB, 256, (bT << 8) | bM);
+
+    // Reset table entry
+    pC->bE = OS.dcb.dstats;
+    pC->bT = bT;
+    pC->bX = 0;
+    pC->bO = (pC->bE == FNSOK);
+    pC->bC = pC->bO;
+
+    // Take interrupts for unit, check it once to start
+    if (pC->bO) {
+        asm("sei");
+        bFNPrM |= cFNBit[bU - 1];
+        bFNPrc |= cFNBit[bU - 1];
+        asm("cli");
+    }
 
-    return OS.dcb.dstats;
+    return (pC->bO ? bU : 0);
 }
 
 
 // -----------------------------------
-// Proc..: unsigned char FNClose(void)
+// Proc..: unsigned char FNCloseU(unsigned char bH)
 // Desc..: Closes connection
+// Params: bH = connection handle
 // Return: SIO status (FNSOK = Success)
 // -----------------------------------
-unsigned char FNClose(void)
+unsigned char FNCloseU(unsigned char bH)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNDEVID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNCCLOSE;
-    OS.dcb.dstats = DCBNONE;
-    OS.dcb.dbuf   = NULL;  // 0
-    OS.dcb.dbyt   = 0;
-    OS.dcb.daux1  = 0;
-    OS.dcb.daux2  = 0;
-    OS.dcb.dtimlo = 15;
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
 
     // Call SIO
-    SIOV();
+    SIOReq(&cFNTClos, bH, NULL, 0, 0);
+
+    // No more interrupts for unit
+    asm("sei");
+    bFNPrM &= ~cFNBit[bH - 1];
+    bFNPrc &= ~cFNBit[bH - 1];
+    asm("cli");
+
+    // Mark closed, drop event callback
+    pFNEvt[bH - 1] = NULL;
+    sFNCon[bH - 1].bO = FALSE;
+    sFNCon[bH - 1].bC = FALSE;
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
 
     return OS.dcb.dstats;
 }
 
 
 // -----------------------------------
-// Proc..: unsigned short FNCheck(void)
-// Desc..: Checks for bytes waiting
+// Proc..: unsigned short FNWaitU(unsigned char bH)
+// Desc..: Gets bytes waiting whether connected or not
+// Params: bH = connection handle
 // DCB returns 4 bytes: 0 = LO byte # bytes waiting
 //                      1 = HI byte # bytes waiting
 //                      2 = Connection State (0=Disconnected, 1=Connected)
 //                      3 = Extended error code
-// Return: # of bytes waiting
+// Return: # of bytes waiting (0 if bad handle)
+// Note..: Connection state and extended error are kept in
+//         sFNCon (bC, bX), see FNErrU.  Bytes the server
+//         sent before closing are still counted, so readers
+//         can drain them before ending.
+//         Clears data ready flag unless bytes are waiting
+//         or disconnected.
 // -----------------------------------
-unsigned short FNCheck(void)
+unsigned short FNWaitU(unsigned char bH)
 {
-    unsigned short iS = 0;
+    unsigned short iS;
     unsigned char cS[4] = { 0, 0, 0, 0 };
+    td_fncon *pC;
 
-    // Setup DCB
-    OS.dcb.ddevic = FNDEVID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNCSTAT;
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = &cS;
-    OS.dcb.dbyt   = 4;
-    OS.dcb.daux1  = 0;
-    OS.dcb.daux2  = 0;
-    OS.dcb.dtimlo = 15;
+    // Check handle
+    if (FNBADH(bH)) {
+        return 0;
+    }
+    pC = &sFNCon[bH - 1];
+
+    // Clear ready flag first so a PROCEED during the
+    // status call is not lost
+    asm("sei");
+    bFNPrc &= ~cFNBit[bH - 1];
+    asm("cli");
 
     // Call SIO
-    SIOV();
+    SIOReq(&cFNTChk, bH, &cS, 4, 0);
+
+    // Record status
+    pC->bE = OS.dcb.dstats;
+    pC->bC = cS[2];
+    pC->bX = cS[3];
+
+    // Get bytes waiting
+    iS = (cS[1] << 8) + cS[0];
+
+    // Still ready if anything to handle
+    if ((iS != 0) || (cS[2] == 0)) {
+        asm("sei");
+        bFNPrc |= cFNBit[bH - 1];
+        asm("cli");
+    }
+
+    return iS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short FNCheckU(unsigned char bH)
+// Desc..: Checks for bytes waiting
+// Params: bH = connection handle
+// Return: # of bytes waiting, FNEDISCO if disconnected or
+//         bad handle
+// Note..: See FNWaitU.  Bytes left after a disconnect are
+//         not reported here, use FNWaitU to drain them.
+// -----------------------------------
+unsigned short FNCheckU(unsigned char bH)
+{
+    unsigned short iS;
+
+    // Check handle
+    if (FNBADH(bH)) {
+        return (unsigned short) FNEDISCO;
+    }
 
     // If disconnected, return error
-    if (cS[2] == 0) {
+    iS = FNWaitU(bH);
+    if (sFNCon[bH - 1].bC == 0) {
         iS = FNEDISCO;
-    } else {
-        // Get bytes waiting
-        iS = (cS[1] << 8) + cS[0];
     }
 
     return iS;
@@ -179,61 +289,348 @@ unsigned short FNCheck(void)
 
 
 // -----------------------------------
-// Proc..: unsigned char FNRead(unsigned short iS, unsigned char *cB)
+// Proc..: unsigned char FNReadU(unsigned char bH, unsigned short iS, unsigned char *cB)
 // Desc..: Reads x bytes from device
-// Params: iS = # of bytes to read
+// Params: bH = connection handle
+//         iS = # of bytes to read
 //         cB = buffer to store read bytes
 // DCB setup: dbyt = # of bytes to get
 //            aux  = # of bytes to get
 // Return: SIO status (FNSOK = Success)
 // -----------------------------------
-unsigned char FNRead(unsigned short iS, unsigned char *cB)
+unsigned char FNReadU(unsigned char bH, unsigned short iS, unsigned char *cB)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNDEVID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNCREAD;
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = cB;
-    OS.dcb.dbyt   = iS;
-    OS.dcb.daux   = iS;
-    OS.dcb.dtimlo = 15;
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
 
     // Call SIO
-    SIOV();
+    SIOReq(&cFNTRead, bH, cB, iS, iS);
+
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
 
     return OS.dcb.dstats;
 }
 
 
 // -----------------------------------
-// Proc..: unsigned char FNWrite(unsigned char *cB)
-// Desc..: Write buffer to device
-// Params: cB = buffer to write to device
+// Proc..: unsigned char FNWriteNU(unsigned char bH, unsigned char *cB, unsigned short iS)
+// Desc..: Write bytes to device
+// Params: bH = connection handle
+//         cB = buffer to write to device
+//         iS = # of bytes to write
 // DCB setup: dbuf = address of buffer
 //            dbyt = # of bytes to write
 //            aux  = # of bytes to write
 // Return: SIO status (FNSOK = Success)
+// Note..: Binary safe (may contain NUL bytes).
 // -----------------------------------
-unsigned char FNWrite(unsigned char *cB)
+unsigned char FNWriteNU(unsigned char bH, unsigned char *cB, unsigned short iS)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNDEVID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNCWRITE;
-    OS.dcb.dstats = DCBWRITE;
-    OS.dcb.dbuf   = cB;
-    OS.dcb.dbyt   = strlen(cB);
-    OS.dcb.daux   = strlen(cB);
-    OS.dcb.dtimlo = 15;
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
 
     // Call SIO
-    SIOV();
+    SIOReq(&cFNTWrit, bH, cB, iS, iS);
+
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
+
+    return OS.dcb.dstats;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNWriteU(unsigned char bH, unsigned char *cB)
+// Desc..: Write string to device
+// Params: bH = connection handle
+//         cB = string to write to device
+// Return: SIO status (FNSOK = Success)
+// -----------------------------------
+unsigned char FNWriteU(unsigned char bH, unsigned char *cB)
+{
+    return FNWriteNU(bH, cB, strlen(cB));
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNErrU(unsigned char bH)
+// Desc..: Gets last SIO status of a connection
+// Params: bH = connection handle
+// Return: SIO status (FNSOK = Success)
+// Note..: Extended error and connection state from the
+//         last FNCheckU are in sFNCon[bH - 1].
+// -----------------------------------
+unsigned char FNErrU(unsigned char bH)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
+
+    return sFNCon[bH - 1].bE;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNChanMode(unsigned char bH, unsigned char bM)
+// Desc..: Sets connection channel mode
+// Params: bH = connection handle
+//         bM = FNCHMPROT = protocol (raw data)
+//              FNCHMJSON = JSON
+// Return: SIO status (FNSOK = Success)
+// -----------------------------------
+unsigned char FNChanMode(unsigned char bH, unsigned char bM)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
+
+    // Call SIO (aux2 = mode)
+    SIOReq(&cFNTChMd, bH, NULL, 0, bM << 8);
+
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
 
     return OS.dcb.dstats;
 }
 
 
+// -----------------------------------
+// Proc..: unsigned char FNJsonParse(unsigned char bH)
+// Desc..: Has FujiNet parse the JSON response
+// Params: bH = connection handle
+// Return: SIO status (FNSOK = Success)
+// Note..: Sets JSON channel mode first.  The document stays
+//         on the FujiNet, use FNJsonQuery to get values.
+// -----------------------------------
+unsigned char FNJsonParse(unsigned char bH)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
+
+    // Switch to JSON
+    if (FNChanMode(bH, FNCHMJSON) != FNSOK) {
+        return OS.dcb.dstats;
+    }
+
+    // Call SIO
+    SIOReq(&cFNTPars, bH, NULL, 0, 0);
+
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
+
+    return OS.dcb.dstats;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short FNJsonQuery(unsigned char bH, char *cP, unsigned char *cB, unsigned short iM)
+// Desc..: Gets a value from the parsed JSON document
+// Params: bH = connection handle
+//         cP = query path, ie "/current/temp" (up to 256 bytes)
+//         cB = buffer for value (0 terminated)
+//         iM = size of buffer (at least 1)
+// Return: length of value, 0 if none (or iM is 0)
+// Note..: Call FNJsonParse first.  Trailing EOL is removed.
+// -----------------------------------
+unsigned short FNJsonQuery(unsigned char bH, char *cP, unsigned char *cB, unsigned short iM)
+{
+    unsigned short iW = 0;
+
+    // Check handle, need room for terminator
+    if (FNBADH(bH) || (iM == 0)) {
+        return 0;
+    }
+
+    // Call SIO
+    SIOReq(&cFNTQury, bH, cP, 256, 0);
+
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
+
+    // Get value, as much as fits
+    if (OS.dcb.dstats == FNSOK) {
+        iW = FNCheckU(bH);
+        if (iW == (unsigned short) FNEDISCO) {
+            iW = 0;
+        }
+        if (iW > iM - 1) {
+            iW = iM - 1;
+        }
+        if ((iW > 0) && (FNReadU(bH, iW, cB) != FNSOK)) {
+            iW = 0;
+        }
+    }
+
+    // Remove EOL and terminate
+    if ((iW > 0) && (cB[iW - 1] == CHENT)) {
+        iW--;
+    }
+    cB[iW] = '\0';
+
+    return iW;
+}
+
+
+// -----------------------------------
+// Proc..: void FNPrcISR(void)
+// Desc..: PROCEED interrupt handler
+// Note..: Assembly only, no C stack use allowed here.
+//         Sets data ready flag of all open units.
+//         OS pushed A before jumping through VPRCED.
+// -----------------------------------
+void FNPrcISR(void)
+{
+    asm("lda %v", bFNPrM);
+    asm("ora %v", bFNPrc);
+    asm("sta %v", bFNPrc);
+    asm("pla");
+    asm("rti");
+}
+
+
+// -----------------------------------
+// Proc..: void FNPrcOn(void)
+// Desc..: Starts PROCEED data ready service
+// Note..: Service is removed at program exit.
+//         Use FNDataReady to skip FNCheckU when nothing
+//         has arrived.
+// -----------------------------------
+void FNPrcOn(void)
+{
+    // Only install once
+    if (bFNPrOn == FALSE) {
+        // Save old vector, set ours, enable PROCEED interrupt
+        asm("sei");
+        wFNPrOv = PEEKW(VPRCED);
+        POKEW(VPRCED, (unsigned short) FNPrcISR);
+        POKE(PACTL, PEEK(PACTL) | 1);
+        asm("cli");
+
+        // Check open units once to start
+        bFNPrc = bFNPrM;
+
+        // Set installed and remove at exit
+        bFNPrOn = TRUE;
+        atexit(FNPrcOff);
+    }
+}
+
+
+// -----------------------------------
+// Proc..: void FNPrcOff(void)
+// Desc..: Stops PROCEED data ready service
+// -----------------------------------
+void FNPrcOff(void)
+{
+    // Only if installed
+    if (bFNPrOn == TRUE) {
+        // Disable PROCEED interrupt, restore old vector
+        asm("sei");
+        POKE(PACTL, PEEK(PACTL) & 0xFE);
+        POKEW(VPRCED, wFNPrOv);
+        asm("cli");
+
+        bFNPrOn = FALSE;
+    }
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNDataReady(unsigned char bH)
+// Desc..: Checks if connection may have data or status
+// Params: bH = connection handle
+// Return: TRUE if FNCheckU should be called, else FALSE
+// Note..: No SIO call.  Always TRUE if service is off.
+// -----------------------------------
+unsigned char FNDataReady(unsigned char bH)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return FALSE;
+    }
+
+    if (bFNPrOn == FALSE) {
+        return TRUE;
+    }
+
+    return ((bFNPrc & cFNBit[bH - 1]) != 0);
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNTimer(unsigned char bH, unsigned short iM)
+// Desc..: Sets FujiNet interrupt timer for connection
+// Params: bH = connection handle
+//         iM = interval in milliseconds (FNTMOFF = off)
+// Return: SIO status (FNSOK = Success)
+// Note..: FujiNet raises PROCEED at most once per interval
+//         while the connection has data or status waiting,
+//         so idle connections cost no SIO calls.
+// -----------------------------------
+unsigned char FNTimer(unsigned char bH, unsigned short iM)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
+
+    // Call SIO (aux = interval)
+    SIOReq(&cFNTTimr, bH, NULL, 0, iM);
+
+    sFNCon[bH - 1].bE = OS.dcb.dstats;
+
+    return OS.dcb.dstats;
+}
+
+
+// -----------------------------------
+// Proc..: void FNEvtSet(unsigned char bH, td_fnevt pF)
+// Desc..: Sets event callback for connection
+// Params: bH = connection handle
+//         pF = callback, or NULL for none
+// Note..: Callback is dropped when connection is closed.
+// -----------------------------------
+void FNEvtSet(unsigned char bH, td_fnevt pF)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return;
+    }
+
+    pFNEvt[bH - 1] = pF;
+}
+
+// -----------------------------------
+// Proc..: void FNEvtPoll(void)
+// Desc..: Runs callbacks for connections with events
+// Note..: Only units flagged by PROCEED (FNDataReady) are
+//         checked, one FNCheckU each.  Callback gets the
+//         bytes waiting and should read them, else it is
+//         called again next poll.
+//         Can be run as an idle task, ie
+//           KIdleAdd(FNEvtPoll, 10);
+// -----------------------------------
+void FNEvtPoll(void)
+{
+    unsigned short iS;
+    unsigned char bL;
+
+    for (bL = 1; bL <= FNUNITS; bL++) {
+        // Open, has callback, and flagged
+        if (sFNCon[bL - 1].bO && pFNEvt[bL - 1] && FNDataReady(bL)) {
+            iS = FNCheckU(bL);
+            if (iS != 0) {
+                pFNEvt[bL - 1](bL, iS);
+            }
+        }
+    }
+}
+
+
 // -----------------------------------
 // Proc..: unsigned char FNGConfig(td_fncfg *sC)
 // Desc..: Get FujiNet config info
@@ -242,19 +639,8 @@ unsigned char FNWrite(unsigned char *cB)
 // -----------------------------------
 unsigned char FNGConfig(td_fncfg *sC)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNRGCONFIG;
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = sC;
-    OS.dcb.dbyt   = FNCONFIGSZ;
-    OS.dcb.daux1  = 0;
-    OS.dcb.daux2  = 0;
-    OS.dcb.dtimlo = 15;
-
     // Call SIO
-    SIOV();
+    SIOReq(&cFNTGCfg, 1, sC, FNCONFIGSZ, 0);
 
     return OS.dcb.dstats;
 }
@@ -4,9 +4,16 @@
 // Author.: Wade Ripkowski
 // Date...: 2023.08
 // License: GNU General Public License v3.0
-// Note...: -Requires: a8deffuji.h, a8defines.h, a8libsio.c
+// Note...: -Requires: a8deffuji.h, a8defines.h, a8libsio.c,
+//                     a8libb64.c
 //          -N: does not need to be loaded.
-// Revised:
+// Revised: 2026.11.03-Calls SIO through SIOCall with call classes.
+//          2026.11.05-DCB set from const templates (SIOReq).
+//          2026.11.06-Added chunked pipeline.
+//          2026.11.08-Added FNB64Auto (local or FujiNet).
+//          2026.11.13-FNB64Auto stays local unless B64FNMIN set.
+//                     FNB64Feed skips non Base64 characters when
+//                     decoding (FNB64Put).
 // --------------------------------------------------
 // Portions are derivative works based on nio.c as
 // found in many of the FujiNet application sources
@@ -18,6 +25,22 @@
 #include "a8defsio.h"
 #include "a8deffuji.h"
 #include "a8deffujib64.h"
+#include "a8defb64.h"
+
+
+// --------------------------------------------------
+// DCB templates: device, unit, command, direction, buffer,
+// timeout, call class, bytes, aux.
+// SIOReq patches unit, buffer, bytes, and aux.
+// --------------------------------------------------
+const td_siodcb cB64TEInp = { FNRAWID, 1, FNRB64ENCINP, DCBWRITE, NULL, 0, SIOPDATA, 0, 0 };
+const td_siodcb cB64TDInp = { FNRAWID, 1, FNRB64DECINP, DCBWRITE, NULL, 0, SIOPDATA, 0, 0 };
+const td_siodcb cB64TECmp = { FNRAWID, 1, FNRB64ENCCMP, DCBNONE,  NULL, 0, SIOPSLOW, 0, 0 };
+const td_siodcb cB64TDCmp = { FNRAWID, 1, FNRB64DECCMP, DCBNONE,  NULL, 0, SIOPSLOW, 0, 0 };
+const td_siodcb cB64TELen = { FNRAWID, 1, FNRB64ENCLEN, DCBREAD,  NULL, 0, SIOPFAST, 0, 0 };
+const td_siodcb cB64TDLen = { FNRAWID, 1, FNRB64DECLEN, DCBREAD,  NULL, 0, SIOPFAST, 0, 0 };
+const td_siodcb cB64TEOut = { FNRAWID, 1, FNRB64ENCOUT, DCBREAD,  NULL, 0, SIOPDATA, 0, 0 };
+const td_siodcb cB64TDOut = { FNRAWID, 1, FNRB64DECOUT, DCBREAD,  NULL, 0, SIOPDATA, 0, 0 };
 
 
 // -----------------------------------
@@ -30,18 +53,8 @@
 // -----------------------------------
 unsigned char FNB64Inp(char cT, char *cB, unsigned short iS)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = (cT == FNLENCODE ? FNRB64ENCINP : FNRB64DECINP);
-    OS.dcb.dstats = DCBWRITE;
-    OS.dcb.dbuf   = cB;
-    OS.dcb.dbyt   = iS;
-    OS.dcb.daux   = iS;
-    OS.dcb.dtimlo = 15;
-
     // Call SIO
-    SIOV();
+    SIOReq((cT == FNLENCODE ? &cB64TEInp : &cB64TDInp), 1, cB, iS, iS);
 
     return OS.dcb.dstats;
 }
@@ -55,18 +68,8 @@ unsigned char FNB64Inp(char cT, char *cB, unsigned short iS)
 // -----------------------------------
 unsigned char FNB64Cmp(char cT)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = (cT == FNLENCODE ? FNRB64ENCCMP : FNRB64DECCMP);
-    OS.dcb.dstats = DCBNONE;
-    OS.dcb.dbuf   = NULL;
-    OS.dcb.dbyt   = 0;
-    OS.dcb.daux   = 0;
-    OS.dcb.dtimlo = 15;
-
     // Call SIO
-    SIOV();
+    SIOReq((cT == FNLENCODE ? &cB64TECmp : &cB64TDCmp), 1, NULL, 0, 0);
 
     return OS.dcb.dstats;
 }
@@ -81,18 +84,8 @@ unsigned char FNB64Cmp(char cT)
 // -----------------------------------
 unsigned char FNB64Len(char cT, unsigned long *iS)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = (cT == FNLENCODE ? FNRB64ENCLEN : FNRB64DECLEN);
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = iS;
-    OS.dcb.dbyt   = 4;   // sizeof(unsigned long)
-    OS.dcb.daux   = 0;
-    OS.dcb.dtimlo = 15;
-
     // Call SIO
-    SIOV();
+    SIOReq((cT == FNLENCODE ? &cB64TELen : &cB64TDLen), 1, iS, 4, 0);   // sizeof(unsigned long)
 
     return OS.dcb.dstats;
 }
@@ -108,18 +101,223 @@ unsigned char FNB64Len(char cT, unsigned long *iS)
 // -----------------------------------
 unsigned char FNB64Out(char cT, char *cB, unsigned short iS)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = (cT == FNLENCODE ? FNRB64ENCOUT : FNRB64DECOUT);
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = cB;
-    OS.dcb.dbyt   = iS;
-    OS.dcb.daux   = iS;
-    OS.dcb.dtimlo = 15;
-
     // Call SIO
-    SIOV();
+    SIOReq((cT == FNLENCODE ? &cB64TEOut : &cB64TDOut), 1, cB, iS, iS);
 
     return OS.dcb.dstats;
 }
+
+
+// -----------------------------------
+// Proc..: void FNB64Begin(td_b64 *pS, char cT, td_b64cb pF, unsigned char *cO, unsigned short iZ)
+// Desc..: Starts a chunked Base64 encode/decode
+// Params: pS = pointer to pipeline state
+//         cT = operation type (FNLENCODE/FNLDECODE)
+//         pF = function called with each output chunk
+//         cO = output buffer
+//         iZ = size of output buffer
+// Note..: Feed input with FNB64Feed, finish with FNB64End.
+//         Output is never more than iZ bytes at a time.
+// -----------------------------------
+void FNB64Begin(td_b64 *pS, char cT, td_b64cb pF, unsigned char *cO, unsigned short iZ)
+{
+    pS->cT = cT;
+    pS->bG = (cT == FNLENCODE ? 3 : 4);
+    pS->bC = 0;
+    pS->pF = pF;
+    pS->cO = cO;
+    pS->iZ = iZ;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNB64Run(td_b64 *pS)
+// Desc..: Computes input sent so far, hands out the result
+// Params: pS = pointer to pipeline state
+// Return: SIO status (FNSOK = Success)
+// -----------------------------------
+unsigned char FNB64Run(td_b64 *pS)
+{
+    unsigned long lL;
+    unsigned short iS;
+    unsigned char bS;
+
+    // Compute and get result length
+    bS = FNB64Cmp(pS->cT);
+    if (bS == FNSOK) {
+        bS = FNB64Len(pS->cT, &lL);
+    }
+
+    // Get result in output buffer sized pieces
+    while ((bS == FNSOK) && (lL > 0)) {
+        iS = (lL > pS->iZ ? pS->iZ : lL);
+        bS = FNB64Out(pS->cT, pS->cO, iS);
+        if (bS == FNSOK) {
+            pS->pF(pS->cO, iS);
+            lL -= iS;
+        }
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNB64Put(td_b64 *pS, unsigned char *cB, unsigned short iS)
+// Desc..: Sends whole groups of input, carries the rest
+// Params: pS = pointer to pipeline state
+//         cB = input
+//         iS = # of bytes in input
+// Return: SIO status (FNSOK = Success)
+// Note..: Only whole groups (3 bytes to encode, 4 to
+//         decode) are sent, the rest is carried to the
+//         next call.  The FujiNet appends input, so the
+//         carry and input are sent without copying them
+//         together.  Sets bN if anything was sent.
+// -----------------------------------
+unsigned char FNB64Put(td_b64 *pS, unsigned char *cB, unsigned short iS)
+{
+    unsigned char bS = FNSOK;
+    unsigned short iL;
+
+    // Finish carried group first
+    if (pS->bC > 0) {
+        while ((pS->bC < pS->bG) && (iS > 0)) {
+            pS->cC[pS->bC++] = *(cB++);
+            iS--;
+        }
+        if (pS->bC == pS->bG) {
+            bS = FNB64Inp(pS->cT, pS->cC, pS->bG);
+            pS->bC = 0;
+            pS->bN = TRUE;
+        }
+    }
+
+    // Send whole groups
+    iL = iS - (iS % pS->bG);
+    if ((bS == FNSOK) && (iL > 0)) {
+        bS = FNB64Inp(pS->cT, cB, iL);
+        pS->bN = TRUE;
+    }
+
+    // Carry the rest
+    for (; iL < iS; iL++) {
+        pS->cC[pS->bC++] = cB[iL];
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNB64Feed(td_b64 *pS, unsigned char *cB, unsigned short iS)
+// Desc..: Feeds a chunk of input
+// Params: pS = pointer to pipeline state
+//         cB = input chunk
+//         iS = # of bytes in chunk
+// Return: SIO status (FNSOK = Success)
+// Note..: Input is sent in whole groups (see FNB64Put).
+//         When decoding, characters that are not Base64
+//         (EOL, CR/LF, spaces) are skipped, so wrapped
+//         input keeps its groups aligned.  Output goes to
+//         the callback.
+// -----------------------------------
+unsigned char FNB64Feed(td_b64 *pS, unsigned char *cB, unsigned short iS)
+{
+    unsigned char bS = FNSOK;
+    unsigned short iL;
+
+    pS->bN = FALSE;
+
+    // Encode takes any bytes
+    if (pS->cT == FNLENCODE) {
+        bS = FNB64Put(pS, cB, iS);
+    }
+    else {
+        // Decode sends runs of Base64 characters (and pad)
+        while ((bS == FNSOK) && (iS > 0)) {
+            for (iL = 0; (iL < iS) && (! B64Skip(cB[iL])); iL++) {}
+            if (iL > 0) {
+                bS = FNB64Put(pS, cB, iL);
+            }
+
+            // Skip the others
+            for (; (iL < iS) && B64Skip(cB[iL]); iL++) {}
+            cB += iL;
+            iS -= iL;
+        }
+    }
+
+    // Compute and hand out
+    if ((bS == FNSOK) && pS->bN) {
+        bS = FNB64Run(pS);
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNB64End(td_b64 *pS)
+// Desc..: Finishes a chunked Base64 encode/decode
+// Params: pS = pointer to pipeline state
+// Return: SIO status (FNSOK = Success)
+// Note..: Sends the carried partial group (padded by
+//         FujiNet when encoding).
+// -----------------------------------
+unsigned char FNB64End(td_b64 *pS)
+{
+    unsigned char bS = FNSOK;
+
+    if (pS->bC > 0) {
+        bS = FNB64Inp(pS->cT, pS->cC, pS->bC);
+        pS->bC = 0;
+        if (bS == FNSOK) {
+            bS = FNB64Run(pS);
+        }
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short FNB64Auto(char cT, unsigned char *cI, unsigned short iS, unsigned char *cO)
+// Desc..: Base64 encodes/decodes locally or on FujiNet
+// Params: cT = operation type (FNLENCODE/FNLDECODE)
+//         cI = input buffer
+//         iS = # of bytes in input
+//         cO = output buffer (see B64Enc/B64Dec for size)
+// Return: # of bytes in output
+// Note..: Done locally if B64FNMIN is 0 (default), the
+//         input is smaller than B64FNMIN, or no FujiNet is
+//         present.  If a FujiNet call fails it is done
+//         locally as well.
+//         Output is zero terminated.
+// -----------------------------------
+unsigned short FNB64Auto(char cT, unsigned char *cI, unsigned short iS, unsigned char *cO)
+{
+    unsigned long lL;
+    unsigned char bS;
+
+    // Use FujiNet if enabled, big enough, and present
+    if ((B64FNMIN > 0) && (iS >= B64FNMIN) && (! SIODevAbs(FNRAWID, 1))) {
+        bS = FNB64Inp(cT, cI, iS);
+        if (bS == FNSOK) {
+            bS = FNB64Cmp(cT);
+        }
+        if (bS == FNSOK) {
+            bS = FNB64Len(cT, &lL);
+        }
+        if (bS == FNSOK) {
+            bS = FNB64Out(cT, cO, lL);
+        }
+        if (bS == FNSOK) {
+            cO[lL] = 0;
+            return lL;
+        }
+    }
+
+    // Do it here
+    return (cT == FNLENCODE ? B64Enc(cI, iS, cO) : B64Dec(cI, iS, cO));
+}
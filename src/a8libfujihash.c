@@ -6,7 +6,10 @@
 // License: GNU General Public License v3.0
 // Note...: -Requires: a8deffuji.h, a8defines.h, a8libsio.c
 //          -N: does not need to be loaded.
-// Revised:
+// Revised: 2026.11.03-Calls SIO through SIOCall with call classes.
+//          2026.11.05-DCB set from const templates (SIOReq).
+//          2026.11.07-Added FNHashUpdate, FNHashFile.
+//          2026.11.13-FNHashFile clears sent input on error.
 // --------------------------------------------------
 // Portions are derivative works based on nio.c as
 // found in many of the FujiNet application sources
@@ -14,12 +17,27 @@
 // --------------------------------------------------
 
 #include <atari.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "a8defines.h"
 #include "a8defsio.h"
 #include "a8deffuji.h"
 #include "a8deffujihash.h"
 
 
+// --------------------------------------------------
+// DCB templates: device, unit, command, direction, buffer,
+// timeout, call class, bytes, aux.
+// SIOReq patches unit, buffer, bytes, and aux.
+// --------------------------------------------------
+const td_siodcb cHshTInp = { FNRAWID, 1, FNRHASHINP, DCBWRITE, NULL, 0, SIOPDATA, 0, 0 };
+const td_siodcb cHshTCmp = { FNRAWID, 1, FNRHASHCMP, DCBNONE,  NULL, 0, SIOPSLOW, 0, 0 };
+const td_siodcb cHshTOut = { FNRAWID, 1, FNRHASHOUT, DCBREAD,  NULL, 0, SIOPDATA, 0, 0 };
+
+// File read block
+unsigned char cHshBf[FNHASHBLK];
+
+
 // -----------------------------------
 // Proc..: unsigned char FNHashInp(char *cB, unsigned short iS)
 // Desc..: Set Hash Input
@@ -29,18 +47,8 @@
 // -----------------------------------
 unsigned char FNHashInp(char *cB, unsigned short iS)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNRHASHINP;
-    OS.dcb.dstats = DCBWRITE;
-    OS.dcb.dbuf   = cB;
-    OS.dcb.dbyt   = iS;
-    OS.dcb.daux   = iS;
-    OS.dcb.dtimlo = 15;
-
     // Call SIO
-    SIOV();
+    SIOReq(&cHshTInp, 1, cB, iS, iS);
 
     return OS.dcb.dstats;
 }
@@ -58,18 +66,8 @@ unsigned char FNHashInp(char *cB, unsigned short iS)
 // -----------------------------------
 unsigned char FNHashCmp(byte bT)
 {
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNRHASHCMP;
-    OS.dcb.dstats = DCBNONE;
-    OS.dcb.dbuf   = NULL;
-    OS.dcb.dbyt   = 0;
-    OS.dcb.daux1  = bT;
-    OS.dcb.dtimlo = 15;
-
-    // Call SIO
-    SIOV();
+    // Call SIO (aux1 = hash type)
+    SIOReq(&cHshTCmp, 1, NULL, 0, bT);
 
     return OS.dcb.dstats;
 }
@@ -104,18 +102,101 @@ unsigned char FNHashOut(byte bT, byte bH, char *cB)
                           break;
     }
 
-    // Setup DCB
-    OS.dcb.ddevic = FNRAWID;
-    OS.dcb.dunit  = 1;
-    OS.dcb.dcomnd = FNRHASHOUT;
-    OS.dcb.dstats = DCBREAD;
-    OS.dcb.dbuf   = cB;
-    OS.dcb.dbyt   = iS;
-    OS.dcb.daux1  = bH;
-    OS.dcb.dtimlo = 15;
-
-    // Call SIO
-    SIOV();
+    // Call SIO (aux1 = output type)
+    SIOReq(&cHshTOut, 1, cB, iS, bH);
 
     return OS.dcb.dstats;
 }
+
+
+// -----------------------------------
+// Proc..: unsigned char FNHashUpdate(char *cB, unsigned short iS)
+// Desc..: Adds a chunk to the hash input
+// Params: cB = pointer to chunk
+//         iS = # of bytes in chunk
+// Return: SIO status (FNSOK = Success)
+// Note..: FujiNet appends each input to what was sent since
+//         the last FNHashCmp, so data can be hashed in pieces.
+//         Chunks larger than FNHASHBLK go in FNHASHBLK frames.
+// -----------------------------------
+unsigned char FNHashUpdate(char *cB, unsigned short iS)
+{
+    unsigned char bS = FNSOK;
+    unsigned short iL;
+
+    // Send a frame at a time
+    while ((bS == FNSOK) && (iS > 0)) {
+        iL = (iS > FNHASHBLK ? FNHASHBLK : iS);
+        bS = FNHashInp(cB, iL);
+        cB += iL;
+        iS -= iL;
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNHashFile(char *pF, byte bT, byte bH, char *cB, td_hashcb pP)
+// Desc..: Hashes a file
+// Params: pF = file name (ie "D1:FILE.DAT")
+//         bT = hash type (see FNHashCmp)
+//         bH = output type (see FNHashOut)
+//         cB = pointer to string for hash (must be big enough to hold hash)
+//         pP = progress function, or NULL for none
+// Return: SIO status (FNSOK = Success), FNHASHEFILE if file
+//         could not be opened or read
+// Note..: File is read in FNHASHBLK blocks, each sent as it
+//         is read, so file size is not limited by RAM.
+//         pP gets the byte count after each block.
+//         On a read or SIO error, input already sent is
+//         cleared with a compute (result not kept), so the
+//         next hash starts empty.
+// -----------------------------------
+unsigned char FNHashFile(char *pF, byte bT, byte bH, char *cB, td_hashcb pP)
+{
+    unsigned char bS = FNSOK;
+    unsigned long lB = 0;
+    int iF, iR;
+
+    // Open file
+    iF = open(pF, O_RDONLY);
+    if (iF < 0) {
+        return FNHASHEFILE;
+    }
+
+    // Read and send blocks until end of file
+    do {
+        iR = read(iF, cHshBf, FNHASHBLK);
+        if (iR < 0) {
+            bS = FNHASHEFILE;
+        }
+        else if (iR > 0) {
+            bS = FNHashInp(cHshBf, iR);
+            lB += iR;
+
+            // Report progress
+            if (pP) {
+                pP(lB);
+            }
+        }
+    } while ((bS == FNSOK) && (iR > 0));
+
+    close(iF);
+
+    // Failed partway, compute to clear input sent so far
+    if (bS != FNSOK) {
+        if (lB > 0) {
+            FNHashCmp(bT);
+        }
+        return bS;
+    }
+
+    // Compute and get hash
+    bS = FNHashCmp(bT);
+    if (bS == FNSOK) {
+        bS = FNHashOut(bT, bH, cB);
+    }
+
+    return bS;
+}
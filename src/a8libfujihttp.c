@@ -0,0 +1,355 @@
+// --------------------------------------------------
+// Library: a8libfujihttp.c
+// Desc...: Atari 8 Bit FujiNet HTTP Library
+// Author.: Wade Ripkowski
+// Date...: 2026.11
+// License: GNU General Public License v3.0
+// Note...: -Requires: a8deffujihttp.h, a8deffuji.h, a8defsio.h,
+//                     a8defines.h, a8libfuji.c, a8libsio.c,
+//                     a8libmisc.c (KeyJif)
+//          -Typical GET: FNHttpOpen, FNHttpCollect (optional),
+//           FNHttpGetHdr, FNHttpBody, FNClose(U).
+//          -Typical POST: FNHttpOpen, FNHttpSetHdr, FNHttpPost,
+//           FNHttpBody, FNClose(U).
+// Require: string.h, stdlib.h
+// Revised: 2026.11.03-Calls SIO through SIOCall.
+//          2026.11.05-DCB set from const template (SIOReq).
+//          2026.11.13-Unit/handle checked before use (FNBADH).
+//          2026.11.14-Callers check FNHttpMode status.
+//                     FNHttpHdrNum gives 0 for a missing header.
+//                     Headers and body drain bytes left after a
+//                     disconnect (FNWaitU).  FNHttpBody gives up
+//                     after iFNHTm jiffies without data (KeyJif).
+// --------------------------------------------------
+
+#include <atari.h>
+#include <string.h>
+#include <stdlib.h>
+#include "a8defines.h"
+#include "a8defsio.h"
+#include "a8deffuji.h"
+#include "a8deffujihttp.h"
+
+
+// --------------------------------------------------
+// DCB templates: device, unit, command, direction, buffer,
+// timeout, call class, bytes, aux.
+// SIOReq patches unit, buffer, bytes, and aux.
+// --------------------------------------------------
+const td_siodcb cFNHTMode = { FNDEVID, 1, FNPHTTPCH, DCBNONE, NULL, 0, SIOPFAST, 0, 0 };
+
+
+// --------------------------------------------------
+// Current channel mode per unit (handle - 1)
+// --------------------------------------------------
+unsigned char cFNHMd[FNUNITS];
+
+// FNHttpBody wait for data, jiffies (may be changed by app)
+unsigned short iFNHTm = FNHTIME;
+
+
+// -----------------------------------
+// Proc..: unsigned char FNHttpOpen(unsigned char bU, unsigned char bM, char *cU)
+// Desc..: Opens HTTP connection
+// Params: bU = unit (1-8 for N1: to N8:)
+//         bM = method (FNHGET, FNHPOST, FNHPUT, FNHDEL)
+//         cU = URL (N:HTTP://host/path or N:HTTPS://)
+// Return: connection handle, 0 on failure
+// Note..: Opens with NO translation, body channel.
+//         On failure FNHttpStatus(bU) gives the result.
+// -----------------------------------
+unsigned char FNHttpOpen(unsigned char bU, unsigned char bM, char *cU)
+{
+    unsigned char bH;
+
+    // Check unit
+    if (FNBADH(bU)) {
+        return 0;
+    }
+
+    bH = FNOpenMU(bU, cU, bM, FNTRNONE);
+    cFNHMd[bU - 1] = FNHMBODY;
+
+    return bH;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNHttpMode(unsigned char bH, unsigned char bM)
+// Desc..: Sets HTTP channel mode
+// Params: bH = connection handle
+//         bM = mode FNHMBODY = body
+//                   FNHMCOLL = headers to collect
+//                   FNHMGHDR = get collected headers
+//                   FNHMSHDR = set request headers
+//                   FNHMPOST = set post data
+// Return: SIO status (FNSOK = Success)
+// Note..: No SIO call if already in mode.  A failed mode
+//         change is kept as the connection error (FNErrU).
+// -----------------------------------
+unsigned char FNHttpMode(unsigned char bH, unsigned char bM)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return FNEBADH;
+    }
+
+    // Already there
+    if (cFNHMd[bH - 1] == bM) {
+        return FNSOK;
+    }
+
+    // Call SIO (aux2 = mode)
+    SIOReq(&cFNHTMode, bH, NULL, 0, bM << 8);
+
+    // Keep mode if set, else the error
+    if (OS.dcb.dstats == FNSOK) {
+        cFNHMd[bH - 1] = bM;
+    }
+    else {
+        sFNCon[bH - 1].bE = OS.dcb.dstats;
+    }
+
+    return OS.dcb.dstats;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNHttpSetHdr(unsigned char bH, char *cH)
+// Desc..: Adds a request header
+// Params: bH = connection handle
+//         cH = header line, ie "Accept: text/plain"
+// Return: SIO status (FNSOK = Success)
+// Note..: Call before FNHttpPost/FNHttpGetHdr/FNHttpBody.
+// -----------------------------------
+unsigned char FNHttpSetHdr(unsigned char bH, char *cH)
+{
+    unsigned char bS;
+
+    // Not written if mode not set
+    bS = FNHttpMode(bH, FNHMSHDR);
+    if (bS == FNSOK) {
+        bS = FNWriteU(bH, cH);
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNHttpCollect(unsigned char bH, char *cN)
+// Desc..: Asks for a response header to be kept
+// Params: bH = connection handle
+//         cN = header name, ie "Content-Length"
+// Return: SIO status (FNSOK = Success)
+// Note..: Call before the request is made (before
+//         FNHttpGetHdr/FNHttpBody).
+// -----------------------------------
+unsigned char FNHttpCollect(unsigned char bH, char *cN)
+{
+    unsigned char bS;
+
+    // Not written if mode not set
+    bS = FNHttpMode(bH, FNHMCOLL);
+    if (bS == FNSOK) {
+        bS = FNWriteU(bH, cN);
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNHttpPost(unsigned char bH, unsigned char *cB, unsigned short iS)
+// Desc..: Sends POST/PUT data
+// Params: bH = connection handle
+//         cB = data
+//         iS = # of bytes of data
+// Return: SIO status (FNSOK = Success)
+// Note..: May be called more than once to add data.
+// -----------------------------------
+unsigned char FNHttpPost(unsigned char bH, unsigned char *cB, unsigned short iS)
+{
+    unsigned char bS;
+
+    // Not written if mode not set
+    bS = FNHttpMode(bH, FNHMPOST);
+    if (bS == FNSOK) {
+        bS = FNWriteNU(bH, cB, iS);
+    }
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short FNHttpGetHdr(unsigned char bH, unsigned char *cB, unsigned short iM)
+// Desc..: Gets collected response headers
+// Params: bH = connection handle
+//         cB = buffer for headers (0 terminated)
+//         iM = size of buffer (at least 1)
+// Return: # of bytes of headers (0 if iM is 0 or mode
+//         could not be set)
+// Note..: Headers are separated by ATASCII EOL.
+//         Makes the request if not made yet.
+// -----------------------------------
+unsigned short FNHttpGetHdr(unsigned char bH, unsigned char *cB, unsigned short iM)
+{
+    unsigned short iW;
+
+    // Need room for terminator
+    if (iM == 0) {
+        return 0;
+    }
+
+    // Nothing if mode not set
+    cB[0] = '\0';
+    if (FNHttpMode(bH, FNHMGHDR) != FNSOK) {
+        return 0;
+    }
+
+    // Get what is waiting (even if closed), as much as fits
+    iW = FNWaitU(bH);
+    if (iW > iM - 1) {
+        iW = iM - 1;
+    }
+    if (iW > 0) {
+        if (FNReadU(bH, iW, cB) != FNSOK) {
+            iW = 0;
+        }
+    }
+    cB[iW] = '\0';
+
+    return iW;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned long FNHttpHdrNum(unsigned char *cB, char *cN)
+// Desc..: Gets numeric value of a header (ie Content-Length)
+// Params: cB = headers from FNHttpGetHdr
+//         cN = header name
+// Return: header value, 0 if not found
+// Note..: Value follows "Name:" (spaces skipped).
+// -----------------------------------
+unsigned long FNHttpHdrNum(unsigned char *cB, char *cN)
+{
+    unsigned char *pV;
+
+    // Find name
+    pV = strstr(cB, cN);
+    if (pV == NULL) {
+        return 0;
+    }
+
+    // Skip past it and the colon
+    pV += strlen(cN);
+    if (*pV == ':') {
+        pV++;
+    }
+
+    return strtoul(pV, NULL, 10);
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short FNHttpStatus(unsigned char bH)
+// Desc..: Gets HTTP result of request
+// Params: bH = connection handle (or unit if open failed)
+// Return: FNHSOK, FNHSDENY, FNHSNOTF, or FNHSFAIL
+// Note..: FujiNet does not pass the status line through.
+//         It maps 4xx/5xx results to SIO errors, which
+//         are mapped back to the nearest code here.
+//         Makes the request if not made yet.
+// -----------------------------------
+unsigned short FNHttpStatus(unsigned char bH)
+{
+    unsigned short iR = FNHSOK;
+    unsigned char bE;
+
+    // Take open error, else check status
+    bE = FNErrU(bH);
+    if (bE == FNSOK) {
+        FNCheckU(bH);
+        bE = sFNCon[bH - 1].bX;
+    }
+
+    // Map error to status code
+    if (bE == FNHEDENY) {
+        iR = FNHSDENY;
+    }
+    else if (bE == FNHENOTF) {
+        iR = FNHSNOTF;
+    }
+    else if ((bE != FNSOK) && (bE != FNHEEOF)) {
+        iR = FNHSFAIL;
+    }
+
+    return iR;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned long FNHttpBody(unsigned char bH, td_fnhcb pF, unsigned char *cB, unsigned short iZ)
+// Desc..: Reads response body through a callback
+// Params: bH = connection handle
+//         pF = function called with each chunk read
+//         cB = buffer for chunks
+//         iZ = size of buffer
+// Return: # of body bytes read
+// Note..: Reads in the largest chunks waiting that fit.
+//         Returns at end of body, once bytes left after a
+//         disconnect are read, or after iFNHTm jiffies with
+//         no data (FNErrU gives FNHETIME then).
+//         Uses FNDataReady to skip idle status calls.
+// -----------------------------------
+unsigned long FNHttpBody(unsigned char bH, td_fnhcb pF, unsigned char *cB, unsigned short iZ)
+{
+    unsigned long iT = 0;
+    unsigned short iW, iJ;
+    unsigned char bD = FALSE;
+
+    // Check handle (would never be ready)
+    if (FNBADH(bH)) {
+        return 0;
+    }
+
+    // Nothing if mode not set
+    if (FNHttpMode(bH, FNHMBODY) != FNSOK) {
+        return 0;
+    }
+    iJ = KeyJif();
+
+    while (! bD) {
+        if (FNDataReady(bH)) {
+            iW = FNWaitU(bH);
+
+            // Done when nothing left and closed or at EOF
+            if (iW == 0) {
+                bD = ((sFNCon[bH - 1].bC == 0) || (sFNCon[bH - 1].bX == FNHEEOF));
+            }
+            // Read chunk and hand it out
+            else {
+                if (iW > iZ) {
+                    iW = iZ;
+                }
+                if (FNReadU(bH, iW, cB) != FNSOK) {
+                    bD = TRUE;
+                }
+                else {
+                    pF(cB, iW);
+                    iT += iW;
+                    iJ = KeyJif();
+                }
+            }
+        }
+
+        // Give up after iFNHTm jiffies without data
+        if ((! bD) && ((word) (KeyJif() - iJ) >= iFNHTm)) {
+            sFNCon[bH - 1].bE = FNHETIME;
+            bD = TRUE;
+        }
+    }
+
+    return iT;
+}
@@ -0,0 +1,508 @@
+// --------------------------------------------------
+// Library: a8libfujistm.c
+// Desc...: Atari 8 Bit FujiNet Stream Library
+// Author.: Wade Ripkowski
+// Date...: 2026.10
+// License: GNU General Public License v3.0
+// Note...: -Requires: a8deffujistm.h, a8deffuji.h, a8defines.h,
+//                     a8libfuji.c, a8libsio.c,
+//                     a8libmisc.c (KeyJif)
+//          -Reads a connection through a ring buffer, in the
+//           largest chunks the device reports.
+//          -Writes are gathered in a buffer and sent in
+//           full frames (FNWPut, FNWStr, FNWChr, FNWFlush).
+// Require: string.h
+// Revised: 2026.10.28-Added buffered writer.
+//          2026.10.29-Streams are per handle.  N1: has a static
+//                     buffer, others attach one (FNStreamBuf).
+//          2026.10.30-Added FNReadLine.
+//          2026.10.31-Fill skips SIO when PROCEED says no data.
+//          2026.11.12-End of stream on EOF status.  FNReadLine
+//                     gives up after iFNRLTm jiffies without data.
+//          2026.11.13-Stream calls check for an attached buffer
+//                     (FNStm).
+//          2026.11.14-Fill drains bytes left after a disconnect.
+//                     FNReadLine takes an EOL after a full buffer,
+//                     gives 0 for a 1 byte buffer.
+//                     Timed by KeyJif (a8libmisc.c).
+// --------------------------------------------------
+
+#include <atari.h>
+#include <string.h>
+#include "a8defines.h"
+#include "a8deffuji.h"
+#include "a8deffujistm.h"
+
+
+// --------------------------------------------------
+// Streams, one pointer per unit (handle - 1)
+// --------------------------------------------------
+unsigned char cFNSBf[FNSBUFSZ];
+td_fnstm sFNStm1 = { cFNSBf, FNSBUFSZ - 1, 0, 0, 0, FALSE };
+td_fnstm *pFNStm[FNUNITS] = { &sFNStm1 };
+
+// FNReadLine wait for data, jiffies (may be changed by app)
+unsigned short iFNRLTm = FNRLTIME;
+
+
+// --------------------------------------------------
+// Write buffer
+// --------------------------------------------------
+unsigned char cFNWBf[FNWBUFSZ];
+unsigned short iFNWCt = 0;
+unsigned char bFNWHd = 1;
+
+
+// -----------------------------------
+// Proc..: td_fnstm *FNStm(unsigned char bH)
+// Desc..: Gets stream of a connection
+// Params: bH = connection handle
+// Return: pointer to stream state, NULL if bad handle or
+//         no buffer attached (FNStreamBuf)
+// -----------------------------------
+td_fnstm *FNStm(unsigned char bH)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return NULL;
+    }
+
+    return pFNStm[bH - 1];
+}
+
+
+// -----------------------------------
+// Proc..: void FNStreamBuf(unsigned char bH, td_fnstm *pS, unsigned char *cB, unsigned short iZ)
+// Desc..: Attaches a stream buffer to a connection
+// Params: bH = connection handle
+//         pS = pointer to stream state
+//         cB = pointer to ring buffer
+//         iZ = size of ring buffer (must be power of 2)
+// Note..: N1: has a static buffer attached already.
+//         Other units have no stream until attached, stream
+//         calls on them return nothing (FNSEOF, 0, TRUE).
+// -----------------------------------
+void FNStreamBuf(unsigned char bH, td_fnstm *pS, unsigned char *cB, unsigned short iZ)
+{
+    // Check handle
+    if (FNBADH(bH)) {
+        return;
+    }
+
+    pS->cB = cB;
+    pS->iM = iZ - 1;
+    pFNStm[bH - 1] = pS;
+    FNStreamInitU(bH);
+}
+
+
+// -----------------------------------
+// Proc..: void FNStreamInitU(unsigned char bH)
+// Desc..: Empties stream buffer
+// Params: bH = connection handle
+// Note..: Call after FNOpenU.
+// -----------------------------------
+void FNStreamInitU(unsigned char bH)
+{
+    td_fnstm *pS = FNStm(bH);
+
+    // No stream
+    if (pS == NULL) {
+        return;
+    }
+
+    pS->iHd = 0;
+    pS->iTl = 0;
+    pS->iCt = 0;
+    pS->bEn = FALSE;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short FNStreamFillU(unsigned char bH)
+// Desc..: Fills stream buffer from connection
+// Params: bH = connection handle
+// Return: # of bytes added to buffer
+// Note..: One FNWaitU, then one FNReadU per contiguous
+//         free block (at most 2) for the bytes waiting.
+//         Bytes left after the server closed are still
+//         read.  Sets end of stream when nothing is waiting
+//         and disconnected or EOF status, or on read error.
+//         No SIO call if PROCEED service says no data.
+// -----------------------------------
+unsigned short FNStreamFillU(unsigned char bH)
+{
+    td_fnstm *pS = FNStm(bH);
+    unsigned short iR = 0, iW, iS, iZ;
+
+    // No stream
+    if (pS == NULL) {
+        return 0;
+    }
+    iZ = pS->iM + 1;
+
+    // Nothing arrived
+    if (! FNDataReady(bH)) {
+        return 0;
+    }
+
+    // Get bytes waiting, even if disconnected
+    iW = FNWaitU(bH);
+
+    // All read, and disconnected or all sent (ie HTTP body done)
+    if ((iW == 0) && ((sFNCon[bH - 1].bC == 0) || (sFNCon[bH - 1].bX == FNSXEOF))) {
+        pS->bEn = TRUE;
+    }
+
+    // Read while bytes waiting and buffer space free
+    while ((iW > 0) && (pS->iCt < iZ)) {
+        // Size of free space from tail to end or head
+        iS = iZ - pS->iTl;
+        if (iS > iZ - pS->iCt) {
+            iS = iZ - pS->iCt;
+        }
+
+        // Read no more than waiting
+        if (iS > iW) {
+            iS = iW;
+        }
+
+        // Read chunk into buffer at tail
+        if (FNReadU(bH, iS, pS->cB + pS->iTl) != FNSOK) {
+            pS->bEn = TRUE;
+            break;
+        }
+
+        // Account for chunk
+        pS->iTl = (pS->iTl + iS) & pS->iM;
+        pS->iCt += iS;
+        iW -= iS;
+        iR += iS;
+    }
+
+    return iR;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned short FNStreamReadU(unsigned char bH, unsigned char *cB, unsigned short iM)
+// Desc..: Reads bytes from stream
+// Params: bH = connection handle
+//         cB = buffer to store read bytes
+//         iM = max # of bytes to read
+// Return: # of bytes read (0 if none waiting)
+// Note..: Fills buffer from connection only when empty.
+//         Does not wait.
+// -----------------------------------
+unsigned short FNStreamReadU(unsigned char bH, unsigned char *cB, unsigned short iM)
+{
+    td_fnstm *pS = FNStm(bH);
+    unsigned short iR, iS;
+
+    // No stream
+    if (pS == NULL) {
+        return 0;
+    }
+
+    // Fill if empty
+    if (pS->iCt == 0) {
+        FNStreamFillU(bH);
+    }
+
+    // Limit to bytes buffered
+    if (iM > pS->iCt) {
+        iM = pS->iCt;
+    }
+    iR = iM;
+
+    // Copy out up to 2 contiguous blocks
+    while (iM > 0) {
+        iS = pS->iM + 1 - pS->iHd;
+        if (iS > iM) {
+            iS = iM;
+        }
+
+        memcpy(cB, pS->cB + pS->iHd, iS);
+        cB += iS;
+        pS->iHd = (pS->iHd + iS) & pS->iM;
+        pS->iCt -= iS;
+        iM -= iS;
+    }
+
+    return iR;
+}
+
+
+// -----------------------------------
+// Proc..: int FNStreamGetcU(unsigned char bH)
+// Desc..: Gets next byte from stream
+// Params: bH = connection handle
+// Return: byte (0-255), or FNSEOF if none waiting
+// Note..: Use FNStreamEndU to tell end of stream from
+//         no data yet.
+// -----------------------------------
+int FNStreamGetcU(unsigned char bH)
+{
+    td_fnstm *pS = FNStm(bH);
+    int iR = FNSEOF;
+
+    // No stream
+    if (pS == NULL) {
+        return FNSEOF;
+    }
+
+    // Fill if empty
+    if (pS->iCt == 0) {
+        FNStreamFillU(bH);
+    }
+
+    // Take byte at head
+    if (pS->iCt > 0) {
+        iR = pS->cB[pS->iHd];
+        pS->iHd = (pS->iHd + 1) & pS->iM;
+        pS->iCt--;
+    }
+
+    return iR;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNStreamEndU(unsigned char bH)
+// Desc..: Checks for end of stream
+// Params: bH = connection handle
+// Return: TRUE if disconnected and buffer empty (or no
+//         stream), else FALSE
+// -----------------------------------
+unsigned char FNStreamEndU(unsigned char bH)
+{
+    td_fnstm *pS = FNStm(bH);
+
+    // No stream, nothing more will come
+    if (pS == NULL) {
+        return TRUE;
+    }
+
+    return ((pS->bEn == TRUE) && (pS->iCt == 0));
+}
+
+
+// -----------------------------------
+// Proc..: int FNReadLine(unsigned char bH, unsigned char *cB, unsigned short iM)
+// Desc..: Reads a line from stream
+// Params: bH = connection handle
+//         cB = buffer to store line (EOL removed, 0 terminated)
+//         iM = size of buffer (at least 1)
+// Return: length of line, FNSEOF at end of stream (or no
+//         stream, or iM is 0), or FNSTIME if no data came
+//         for iFNRLTm jiffies
+// Note..: Waits for EOL, full buffer, end of stream, or
+//         iFNRLTm jiffies without data (a partial line is
+//         returned then).  Set iFNRLTm to 0 to not wait.
+//         A longer line is returned in buffer sized pieces.
+//         An EOL right after a full buffer is taken with
+//         it.  With iM of 1 only an empty line (0) fits.
+//         EOL is ATASCII EOL if translation is set, else LF
+//         (trailing CR removed).  Scans whole buffered chunk
+//         with memchr, refills only when empty.
+// -----------------------------------
+int FNReadLine(unsigned char bH, unsigned char *cB, unsigned short iM)
+{
+    td_fnstm *pS = FNStm(bH);
+    unsigned char *pH, *pE;
+    unsigned char bE, bF = FALSE, bT = FALSE;
+    unsigned short iL = 0, iS, iJ;
+
+    // Need a stream and room for terminator
+    if ((pS == NULL) || (iM == 0)) {
+        return FNSEOF;
+    }
+
+    // EOL to scan for, leave room for terminator
+    bE = (sFNCon[bH - 1].bT == FNTRNONE ? FNSLF : CHENT);
+    iM--;
+    iJ = KeyJif();
+
+    while ((! bF) && (iL < iM)) {
+        // Refill if empty, stop at end
+        if (pS->iCt == 0) {
+            if (pS->bEn == TRUE) {
+                break;
+            }
+
+            // Restart wait on data, give up after iFNRLTm
+            if (FNStreamFillU(bH) > 0) {
+                iJ = KeyJif();
+            }
+            else if ((pS->bEn == FALSE) && ((word) (KeyJif() - iJ) >= iFNRLTm)) {
+                bT = TRUE;
+                break;
+            }
+        }
+        else {
+            // Contiguous block at head, limited to room left
+            iS = pS->iM + 1 - pS->iHd;
+            if (iS > pS->iCt) {
+                iS = pS->iCt;
+            }
+            if (iS > iM - iL) {
+                iS = iM - iL;
+            }
+
+            // Scan block for EOL
+            pH = pS->cB + pS->iHd;
+            pE = memchr(pH, bE, iS);
+            if (pE != NULL) {
+                iS = pE - pH;
+                bF = TRUE;
+            }
+
+            // Copy up to EOL
+            memcpy(cB + iL, pH, iS);
+            iL += iS;
+
+            // Consume copied bytes and EOL
+            iS += bF;
+            pS->iHd = (pS->iHd + iS) & pS->iM;
+            pS->iCt -= iS;
+        }
+    }
+
+    // Full buffer, take EOL (or CR/LF) that follows so the
+    // next call does not return an empty line
+    if ((! bF) && (iL == iM)) {
+        if ((pS->iCt == 0) && (pS->bEn == FALSE)) {
+            FNStreamFillU(bH);
+        }
+
+        iS = 0;
+        if ((pS->iCt > 0) && (pS->cB[pS->iHd] == bE)) {
+            iS = 1;
+        }
+        else if ((bE == FNSLF) && (pS->iCt > 1) && (pS->cB[pS->iHd] == FNSCR) &&
+                 (pS->cB[(pS->iHd + 1) & pS->iM] == FNSLF)) {
+            iS = 2;
+        }
+
+        if (iS > 0) {
+            pS->iHd = (pS->iHd + iS) & pS->iM;
+            pS->iCt -= iS;
+            bF = TRUE;
+        }
+    }
+
+    // Remove CR of CR/LF
+    if ((bE == FNSLF) && (iL > 0) && (cB[iL - 1] == FNSCR)) {
+        iL--;
+    }
+    cB[iL] = '\0';
+
+    // Nothing more (a 1 byte buffer gives an empty line
+    // until end of stream)
+    if ((iL == 0) && (! bF) && ((iM > 0) || FNStreamEndU(bH))) {
+        return (bT ? FNSTIME : FNSEOF);
+    }
+
+    return iL;
+}
+
+
+// -----------------------------------
+// Proc..: void FNWSetU(unsigned char bH)
+// Desc..: Sets connection the write buffer sends to
+// Params: bH = connection handle
+// Note..: Flushes anything buffered for the previous one.
+//         Default is N1:.
+// -----------------------------------
+void FNWSetU(unsigned char bH)
+{
+    FNWFlush();
+    bFNWHd = bH;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNWFlush(void)
+// Desc..: Sends buffered write bytes
+// Return: SIO status (FNSOK = Success)
+// Note..: Call after last write of a request.
+// -----------------------------------
+unsigned char FNWFlush(void)
+{
+    unsigned char bR = FNSOK;
+
+    // Send buffer if anything in it
+    if (iFNWCt > 0) {
+        bR = FNWriteNU(bFNWHd, cFNWBf, iFNWCt);
+        iFNWCt = 0;
+    }
+
+    return bR;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNWPut(unsigned char *cB, unsigned short iS)
+// Desc..: Adds bytes to write buffer
+// Params: cB = bytes to write
+//         iS = # of bytes to write
+// Return: SIO status (FNSOK = Success)
+// Note..: Sends buffer only when full.  Binary safe.
+// -----------------------------------
+unsigned char FNWPut(unsigned char *cB, unsigned short iS)
+{
+    unsigned char bR = FNSOK;
+    unsigned short iC;
+
+    while ((iS > 0) && (bR == FNSOK)) {
+        // Copy as much as fits
+        iC = FNWBUFSZ - iFNWCt;
+        if (iC > iS) {
+            iC = iS;
+        }
+        memcpy(cFNWBf + iFNWCt, cB, iC);
+        iFNWCt += iC;
+        cB += iC;
+        iS -= iC;
+
+        // Send if full
+        if (iFNWCt == FNWBUFSZ) {
+            bR = FNWFlush();
+        }
+    }
+
+    return bR;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNWStr(unsigned char *cB)
+// Desc..: Adds string to write buffer
+// Params: cB = string to write
+// Return: SIO status (FNSOK = Success)
+// -----------------------------------
+unsigned char FNWStr(unsigned char *cB)
+{
+    return FNWPut(cB, strlen(cB));
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char FNWChr(unsigned char bC)
+// Desc..: Adds one byte to write buffer
+// Params: bC = byte to write
+// Return: SIO status (FNSOK = Success)
+// -----------------------------------
+unsigned char FNWChr(unsigned char bC)
+{
+    unsigned char bR = FNSOK;
+
+    cFNWBf[iFNWCt++] = bC;
+
+    // Send if full
+    if (iFNWCt == FNWBUFSZ) {
+        bR = FNWFlush();
+    }
+
+    return bR;
+}
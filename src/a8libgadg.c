@@ -22,6 +22,11 @@
 //          2025.01.03-Added GConf(), mod GAlert title.
 //          2025.01.05-Fix GInput FNAME to allow 0 and space.
 //          2025.01.11-Alter GAlert to GAlertM.
+//          2026.10.20-Added GView(), GVInit(), GVIdx().
+//          2026.10.22-GSpin and GList accelerate on held keys and
+//                     skip redraws while keys are waiting.
+//          2026.11.14-GView keys are words (console keys), GVIdx
+//                     checks for a 0 size index.
 // --------------------------------------------------
 
 // --------------------------------------------------
@@ -35,6 +40,12 @@
 // --------------------------------------------------
 #define GAlert(a) GAlertM(GAALERT,a)
 
+// --------------------------------------------------
+// Spin step size by key repeat level (KRSLOW/KRMED/KRFAST)
+// --------------------------------------------------
+const byte cGSpSt[3] = { 1, 5, 10 };
+
+
 // --------------------------------------------------
 // Function Prototypes
 // --------------------------------------------------
@@ -48,6 +59,11 @@ byte GRadio(byte bN, byte x, byte y, byte bD, byte bE, byte bI, byte bS, unsigne
 byte GSpin(byte bN, byte x, byte y, byte bL, byte bM, byte bI, byte bE);
 byte GInput(byte bN, byte x, byte y, byte bT, byte bS, unsigned char *pS);
 byte GList(byte bN, byte x, byte y, byte bE, byte bS, byte bM, byte bC, unsigned char **pS);
+void GLDraw(byte bN, byte x, byte y, byte bE, byte bR, byte bI, byte bM, unsigned char **pS);
+void GVInit(td_view *pV, unsigned char *pB, unsigned int *pI, unsigned int iM, byte bW);
+unsigned int GVIdx(td_view *pV, unsigned int iS);
+void GVDraw(byte bN, byte x, byte y, byte bH, td_view *pV);
+byte GView(byte bN, byte x, byte y, byte bH, byte bE, td_view *pV);
 
 
 // ------------------------------------------------------------
@@ -452,10 +468,11 @@ byte GRadio(byte bN, byte x, byte y, byte bD, byte bE, byte bI, byte bS, unsigne
 //          bE = GDISP to display only, GEDIT to edit
 // Return.: selected value or XESC
 // Notes..: Max is 250 (above are form control values)
+//          Held keys step by 1, then 5, then 10.
 // ------------------------------------------------------------
 byte GSpin(byte bN, byte x, byte y, byte bL, byte bM, byte bI, byte bE)
 {
-    byte bD, bK, bR;
+    byte bD, bK, bR, bT;
     byte bF = FALSE;
     unsigned char cL[4];
 
@@ -475,27 +492,35 @@ byte GSpin(byte bN, byte x, byte y, byte bL, byte bM, byte bI, byte bE)
 
     // Loop until exit
     while (! bF) {
-        // Convert to string and display in inverse
-        sprintf(cL, "%3d", bD);
-        WPrint(bN, x, y, WON, cL);
+        // Convert to string and display in inverse,
+        // skipped while more keys are waiting
+        if (! KeyPend()) {
+            sprintf(cL, "%3d", bD);
+            WPrint(bN, x, y, WON, cL);
+        }
 
         // Only adjust if in edit mode
         if (bE == GEDIT) {
-            // Get key
+            // Get key and step size for held keys
             bK = WaitKCX(WOFF);
+            bT = cGSpSt[KeyRep(bK)];
 
             // Process keystroke
             if ((bK == KLEFT) || (bK == KPLUS) || (bK == KDOWN) || (bK == KEQUAL)) {
-                // Decrement only if not 0, then check for underrun
-                bD -= (bD == 0 ? 0 : 1);
-                if (bD < bL) {
+                // Decrement by step, check for underrun
+                if (bD >= bL + bT) {
+                    bD -= bT;
+                }
+                else {
                     bD = bL;
                 }
             }
             else if ((bK == KRIGHT) || (bK == KASTER) || (bK == KUP) || (bK == KMINUS)) {
-                // Increment and check for overrun
-                bD += 1;
-                if (bD > bM) {
+                // Increment by step, check for overrun
+                if (bD + bT <= bM) {
+                    bD += bT;
+                }
+                else {
                     bD = bM;
                 }
             }
@@ -756,12 +781,12 @@ byte GInput(byte bN, byte x, byte y, byte bT, byte bS, unsigned char *pS)
 //          bC = Number of items
 //          pS = pointer to array of item strings
 // Return.: Selected item #, ESC (XESC), or TAB (XTAB)
+// Notes..: Held up/down keys move a row, then a page.
 // ------------------------------------------------------------
 byte GList(byte bN, byte x, byte y, byte bE, byte bS, byte bM, byte bC, unsigned char **pS)
 {
-    byte bF = FALSE, bL = 0, bI = 0, bR = 0;
-    byte bK;
-    unsigned char cL[41];
+    byte bF = FALSE, bL = 0, bI = 0, bR = 0, bV = FALSE;
+    byte bK, bT;
 
     // For display only, set start index to start item
     if (bE == GDISP) {
@@ -773,52 +798,48 @@ byte GList(byte bN, byte x, byte y, byte bE, byte bS, byte bM, byte bC, unsigned
 
     // Continue until finished
     while (! bF) {
-        // Display each item
-        for (bL=0; bL < bM; bL++) {
-            // Get item from array
-            strcpy(cL, pS[bI + bL]);
-
-            // Display item at row count
-            if (bE == GDISP) {
-                // Dont inverse on display only
-                WPrint(bN, x, y + bL, WOFF, cL);
-            } else {
-                // Inverse if selected item
-                WPrint(bN, x, y + bL, (bR == bL + 1 ? WON : WOFF), cL);
-            }
+        // Display items, skipped while more keys are waiting
+        bV = ((bE == GDISP) || (! KeyPend()));
+        if (bV) {
+            GLDraw(bN, x, y, bE, bR, bI, bM, pS);
         }
 
         // Only get if editing
         if (bE == GEDIT) {
-            // Get key (no inverse key)
+            // Get key (no inverse key), move a page if held long
             bK = WaitKCX(WOFF);
+            bT = (KeyRep(bK) == KRFAST ? bM : 1);
 
             // Process key
             if ((bK == KDOWN) || (bK == KEQUAL) || (bK == KRIGHT) || (bK == KASTER)) {
-                // If hilite row < max display
-                if (bR < bM) {
-                    // Increase hilite row
-                    if (bR < bC) {
-                        bR += 1;
-                    }
-                } else {
-                    // If start index < elements - max display
-                    if (bI < bC - bM) {
-                        // Increase start index
-                        bI += 1;
+                for (bL=0; bL < bT; bL++) {
+                    // If hilite row < max display
+                    if (bR < bM) {
+                        // Increase hilite row
+                        if (bR < bC) {
+                            bR += 1;
+                        }
+                    } else {
+                        // If start index < elements - max display
+                        if (bI < bC - bM) {
+                            // Increase start index
+                            bI += 1;
+                        }
                     }
                 }
             }
             else if ((bK == KUP) || (bK == KMINUS) || (bK == KLEFT) || (bK == KPLUS)) {
-                // If hilite row > 1
-                if (bR > 1) {
-                    // Decrease row
-                    bR -= 1;
-                } else {
-                    // If start index > 0
-                    if (bI > 0) {
-                        // Decrease start index
-                        bI -= 1;
+                for (bL=0; bL < bT; bL++) {
+                    // If hilite row > 1
+                    if (bR > 1) {
+                        // Decrease row
+                        bR -= 1;
+                    } else {
+                        // If start index > 0
+                        if (bI > 0) {
+                            // Decrease start index
+                            bI -= 1;
+                        }
                     }
                 }
             }
@@ -842,6 +863,11 @@ byte GList(byte bN, byte x, byte y, byte bE, byte bS, byte bM, byte bC, unsigned
                 }
             }
 
+            // Show final position if last display was skipped
+            if ((! bV) && ((bK == KESC) || (bK == KTAB) || (bK == KENTER))) {
+                GLDraw(bN, x, y, bE, bR, bI, bM, pS);
+            }
+
             // If ESC, set choice to XESC
             if (bK == KESC) {
                 bR = XESC;
@@ -863,3 +889,268 @@ byte GList(byte bN, byte x, byte y, byte bE, byte bS, byte bM, byte bC, unsigned
 
     return(bR);
 }
+
+
+// ------------------------------------------------------------
+// Func...: void GLDraw(byte bN, byte x, byte y, byte bE, byte bR, byte bI, byte bM, unsigned char **pS)
+// Desc...: Draws list control items
+// Param..: bN = Window handle number
+//           x = window column for cursor
+//           y = window row for cursor
+//          bE = Display or Edit flag
+//          bR = Hilite row (1 based)
+//          bI = Start index of first displayed item
+//          bM = Max items to display at one time
+//          pS = pointer to array of item strings
+// ------------------------------------------------------------
+void GLDraw(byte bN, byte x, byte y, byte bE, byte bR, byte bI, byte bM, unsigned char **pS)
+{
+    byte bL;
+    unsigned char cL[41];
+
+    // Display each item
+    for (bL=0; bL < bM; bL++) {
+        // Get item from array
+        strcpy(cL, pS[bI + bL]);
+
+        // Display item at row count
+        if (bE == GDISP) {
+            // Dont inverse on display only
+            WPrint(bN, x, y + bL, WOFF, cL);
+        } else {
+            // Inverse if selected item
+            WPrint(bN, x, y + bL, (bR == bL + 1 ? WON : WOFF), cL);
+        }
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void GVInit(td_view *pV, unsigned char *pB, unsigned int *pI, unsigned int iM, byte bW)
+// Desc...: Initializes text viewer record
+// Param..: pV = Pointer to viewer record
+//          pB = Pointer to text buffer (ATASCII)
+//          pI = Pointer to line index array
+//          iM = Number of entries in line index array
+//          bW = View width (max 40)
+// Notes..: Call GVIdx() to index the text before GView().
+// ------------------------------------------------------------
+void GVInit(td_view *pV, unsigned char *pB, unsigned int *pI, unsigned int iM, byte bW)
+{
+    pV->pB = pB;
+    pV->iS = 0;
+    pV->pI = pI;
+    pV->iM = iM;
+    pV->iC = 0;
+    pV->iT = 0;
+    pV->bW = bW;
+    pV->bL = 0;
+}
+
+
+// ------------------------------------------------------------
+// Func...: unsigned int GVIdx(td_view *pV, unsigned int iS)
+// Desc...: Indexes line starts of text buffer
+// Param..: pV = Pointer to viewer record
+//          iS = Number of bytes now in text buffer
+// Return.: Number of lines indexed
+// Notes..: Lines end at EOL (155) or LF (10), and wrap at view
+//          width.  Picks up where the last call left off, so
+//          text may be added to the buffer in chunks (such as
+//          from a network stream) and indexed as it arrives.
+//          Stops when the line index is full (indexes nothing
+//          if the index size is 0).
+// ------------------------------------------------------------
+unsigned int GVIdx(td_view *pV, unsigned int iS)
+{
+    unsigned int iO;
+    unsigned char bC;
+
+    // No room in index
+    if (pV->iM == 0) {
+        return(0);
+    }
+
+    // First line starts at buffer start
+    if ((pV->iC == 0) && (iS > 0)) {
+        pV->pI[0] = 0;
+        pV->iC = 1;
+    }
+
+    // Scan new bytes for line starts
+    for (iO=pV->iS; iO < iS; iO++) {
+        bC = pV->pB[iO];
+
+        // End of line, next line starts after it
+        if ((bC == CHENT) || (bC == 10)) {
+            if (pV->iC == pV->iM) {
+                break;
+            }
+            pV->pI[pV->iC++] = iO + 1;
+            pV->bL = 0;
+        }
+        // Line full, wrap this char to next line
+        else if (pV->bL == pV->bW) {
+            if (pV->iC == pV->iM) {
+                break;
+            }
+            pV->pI[pV->iC++] = iO;
+            pV->bL = 1;
+        }
+        else {
+            pV->bL++;
+        }
+    }
+
+    // Save indexed position
+    pV->iS = iO;
+
+    return(pV->iC);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void GVDraw(byte bN, byte x, byte y, byte bH, td_view *pV)
+// Desc...: Draws visible lines of text viewer
+// Param..: bN = Window handle number
+//           x = Window column of view
+//           y = Window row of view
+//          bH = View height (rows)
+//          pV = Pointer to viewer record
+// Notes..: Lines go straight to screen memory.
+// ------------------------------------------------------------
+void GVDraw(byte bN, byte x, byte y, byte bH, td_view *pV)
+{
+    byte bL, bS;
+    unsigned int iL, iE;
+    word cS;
+    unsigned char cL[41];
+
+    // Find top left of view in screen memory
+    cS = iSMr[baW.bY[bN] + y] + baW.bX[bN] + x;
+
+    // Draw each row
+    for (bL=0; bL < bH; bL++) {
+        // Set blank line
+        memset(cL, CHSPACE, pV->bW);
+
+        // Get line if there is one
+        iL = pV->iT + bL;
+        if (iL < pV->iC) {
+            // Find line end, next line start or end of text
+            iE = (iL + 1 < pV->iC ? pV->pI[iL + 1] : pV->iS);
+            bS = iE - pV->pI[iL];
+
+            // Drop EOL
+            if ((bS > 0) && ((pV->pB[iE - 1] == CHENT) || (pV->pB[iE - 1] == 10))) {
+                bS--;
+            }
+
+            memcpy(cL, pV->pB + pV->pI[iL], bS);
+        }
+
+        // Convert from ATA to Int
+        StrAI(cL, pV->bW);
+
+        // If window is inverse, flip line
+        if (baW.bI[bN] == WON) {
+            StrInv(cL, pV->bW);
+        }
+
+        // Move line to screen
+        memcpy((char *) cS, cL, pV->bW);
+        cS += 40;
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte GView(byte bN, byte x, byte y, byte bH, byte bE, td_view *pV)
+// Desc...: Paged text viewer
+// Param..: bN = Window handle number
+//           x = Window column of view
+//           y = Window row of view
+//          bH = View height (rows)
+//          bE = Display or Edit flag
+//               GDISP = Display only
+//               GEDIT = Scroll until exit
+//          pV = Pointer to viewer record (indexed with GVIdx)
+// Return.: TRUE on ENTER or display only, ESC (XESC), or TAB (XTAB)
+// Notes..: Up/Down scroll a line, Left/Right scroll a page,
+//          Ctrl-Shft-S/E go to start/end.
+//          Top line is kept in the viewer record.
+// ------------------------------------------------------------
+byte GView(byte bN, byte x, byte y, byte bH, byte bE, td_view *pV)
+{
+    byte bF = FALSE, bR = TRUE;
+    word bK;
+    unsigned int iM, iT;
+
+    // Find last possible top line
+    iM = (pV->iC > bH ? pV->iC - bH : 0);
+
+    // Keep top line in range
+    if (pV->iT > iM) {
+        pV->iT = iM;
+    }
+
+    // Draw initial view
+    GVDraw(bN, x, y, bH, pV);
+
+    // Only get keys if editing
+    while ((bE == GEDIT) && (! bF)) {
+        // Start from current top line
+        iT = pV->iT;
+
+        // Get key
+        bK = WaitKCX(WOFF);
+
+        // Line down
+        if ((bK == KDOWN) || (bK == KEQUAL)) {
+            if (iT < iM) {
+                iT++;
+            }
+        }
+        // Line up
+        else if ((bK == KUP) || (bK == KMINUS)) {
+            if (iT > 0) {
+                iT--;
+            }
+        }
+        // Page down
+        else if ((bK == KRIGHT) || (bK == KASTER)) {
+            iT = (iM - iT > bH ? iT + bH : iM);
+        }
+        // Page up
+        else if ((bK == KLEFT) || (bK == KPLUS)) {
+            iT = (iT > bH ? iT - bH : 0);
+        }
+        // Ctrl-Shft-S (start of text)
+        else if (bK == KEYS_CS) {
+            iT = 0;
+        }
+        // Ctrl-Shft-E (end of text)
+        else if (bK == KEYE_CS) {
+            iT = iM;
+        }
+        else if (bK == KESC) {
+            bR = XESC;
+            bF = TRUE;
+        }
+        else if (bK == KTAB) {
+            bR = XTAB;
+            bF = TRUE;
+        }
+        else if (bK == KENTER) {
+            bF = TRUE;
+        }
+
+        // Only redraw if moved
+        if (iT != pV->iT) {
+            pV->iT = iT;
+            GVDraw(bN, x, y, bH, pV);
+        }
+    }
+
+    return(bR);
+}
@@ -12,6 +12,14 @@
 //          a8libmisc.c
 // Revised: 2024.02.20-Correct GVERT dehilite location.
 //          2025.01.24 - Fix var dec in WaitKCX (byte to word) for key.
+//          2026.10.19 - Added MenuK() with accelerator keys.
+//                       Menu() is now a define for MenuK().
+//                       Only changed items are redrawn on navigation.
+//          2026.10.20 - Added MenuB() pull-down menu bar engine.
+//                       MenuK() is now a define for MenuE().
+//          2026.10.22 - Skip redraws while navigation keys are waiting.
+//          2026.11.14 - MenuB places pull-down after the summed
+//                       lengths of the bar items before it.
 // --------------------------------------------------
 
 // --------------------------------------------------
@@ -24,60 +32,181 @@
 // Defines to preserve backward call compatability.
 // --------------------------------------------------
 #define MenuV(a,b,c,d,e,f,g) Menu(a,b,c,GVERT,d,e,f,g)
+#define Menu(a,b,c,d,e,f,g,h) MenuK(a,b,c,d,e,f,g,h,NULL)
+#define MenuK(a,b,c,d,e,f,g,h,i) MenuE(a,b,c,d,e,f,g,h,i,TRUE)
 
 
 // --------------------------------------------------
 // Function Prototypes
 // --------------------------------------------------
-byte Menu(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned char **pS);
+void MenuI(byte bN, byte x, byte y, byte bO, byte bL, byte bH, unsigned char *pS);
+void MenuKT(byte bC, unsigned char **pS, byte *pK, byte *pT);
+byte MenuE(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned char **pS, byte *pK, byte bD);
+byte MenuB(byte bN, byte x, byte y, byte bS, byte bC, unsigned char **pS, td_mpull *pP, byte *pB);
+
+
+// --------------------------------------------------
+// Keycodes for first letter/digit accelerators
+// --------------------------------------------------
+const byte cMKA[26] = {
+    KEYA, KEYB, KEYC, KEYD, KEYE, KEYF, KEYG, KEYH, KEYI, KEYJ, KEYK, KEYL, KEYM,
+    KEYN, KEYO, KEYP, KEYQ, KEYR, KEYS, KEYT, KEYU, KEYV, KEYW, KEYX, KEYY, KEYZ
+};
+const byte cMKN[10] = {
+    KEY0, KEY1, KEY2, KEY3, KEY4, KEY5, KEY6, KEY7, KEY8, KEY9
+};
 
 
 // ------------------------------------------------------------
-// Func...: byte Menu(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned char **pS)
-// Desc...: Vertical or Horizontal menu
+// Func...: void MenuI(byte bN, byte x, byte y, byte bO, byte bL, byte bH, unsigned char *pS)
+// Desc...: Draws a single menu item
+// Param..: bN = Window handle number
+//           x = window column for cursor
+//           y = window row for cursor
+//          bO = Orientation (GHORZ/GVERT)
+//          bL = Item index (0 based)
+//          bH = Highlight flag (TRUE = selected)
+//          pS = pointer to item string
+// ------------------------------------------------------------
+void MenuI(byte bN, byte x, byte y, byte bO, byte bL, byte bH, unsigned char *pS)
+{
+    // Highlight selection based on orientation
+    if (bO == GHORZ) {
+        // Display item at column offset - inverse if selected
+        WPrint(bN, x+(bL*strlen(pS)), y, (bH ? ! baW.bI[bN] : baW.bI[bN]), pS);
+    } else {
+        // Display item at row count - inverse if selected
+        WPrint(bN, x, y+bL, (bH ? WON : WOFF), pS);
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void MenuKT(byte bC, unsigned char **pS, byte *pK, byte *pT)
+// Desc...: Builds keycode to item accelerator table
+// Param..: bC = Number of menu items
+//          pS = pointer to array of menu item strings
+//          pK = pointer to array of item keycodes (KNONE for none),
+//               or NULL to use first letter/digit of each item
+//          pT = pointer to 64 byte table to fill
+// Notes..: Table is indexed by keycode & 63, so shifted keys
+//          match too.  Entry is item # (1 based), 0 for none.
+//          First item wins when items share a key.
+//          ESC, TAB, and RETURN can not be accelerators.
+// ------------------------------------------------------------
+void MenuKT(byte bC, unsigned char **pS, byte *pK, byte *pT)
+{
+    byte bL, bK;
+    unsigned char *pC;
+
+    // Clear table
+    memset(pT, 0, 64);
+
+    // Work each item
+    for (bL=0; bL < bC; bL++) {
+        bK = KNONE;
+
+        // Explicit keycode, no control keys
+        if (pK != NULL) {
+            if (pK[bL] < 128) {
+                bK = pK[bL] & 63;
+            }
+        }
+        // Else first letter or digit (skip leading spaces)
+        else {
+            pC = pS[bL];
+            while (*pC == CHSPACE) {
+                pC++;
+            }
+
+            if ((*pC >= 'A') && (*pC <= 'Z')) {
+                bK = cMKA[*pC - 'A'];
+            }
+            else if ((*pC >= 'a') && (*pC <= 'z')) {
+                bK = cMKA[*pC - 'a'];
+            }
+            else if ((*pC >= '0') && (*pC <= '9')) {
+                bK = cMKN[*pC - '0'];
+            }
+        }
+
+        // Add to table if not reserved and not already taken
+        if ((bK != KNONE) && (bK != KESC) && (bK != KTAB) && (bK != KENTER) && (pT[bK] == 0)) {
+            pT[bK] = bL + 1;
+        }
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte MenuE(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned char **pS, byte *pK, byte bD)
+// Desc...: Vertical or Horizontal menu with accelerator keys
 // Param..: bN = Window handle number
 //           x = window column for cursor
 //           y = window row for cursor
 //          bO = Orientation
 //               GHORZ = Horizontal (1 line)
 //               GVERT = Vertical   (stacked)
+//               GPULL = Pull-down (vertical, left/right exit)
 //          bI = Inverse flag (WON = leave on at selection)
 //          bS = Start item number
 //          bC = Number of menu items
 //          pS = pointer to array of menu item strings
+//          pK = pointer to array of item keycodes (KNONE for none),
+//               or NULL to use first letter/digit of each item
+//          bD = Draw items flag
+//               TRUE  = draw all items
+//               FALSE = items already shown, highlight start only
 // Return.: Selected item #, ESC (XESC), or TAB (XTAB)
+//          GPULL also returns XLEFT or XRIGHT
+// Notes..: An accelerator key selects and returns its item.
+//          Navigation keys take priority over accelerators.
 // ------------------------------------------------------------
-byte Menu(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned char **pS)
+byte MenuE(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned char **pS, byte *pK, byte bD)
 {
     byte bF = FALSE;
-    byte bL, bR;
+    byte bL, bR, bP;
     word bK;
+    byte cT[64];
     unsigned char cL[41];
 
+    // Build accelerator table
+    MenuKT(bC, pS, pK, cT);
+
     // Set default return to start item #
     bR = bS;
 
+    // Set highlighted item, 0 to draw all, XNONE for none yet
+    bP = (bD ? 0 : XNONE);
+
     // Continue until finished
     while (! bF) {
-        // Display each item
-        for (bL=0; bL<bC; bL++) {
-            strcpy(cL, pS[bL]);
-
-            // Highlight selection based on orientation
-            if (bO == GHORZ) {
-                // Display item at row count - inverse if start item
-                WPrint(bN, x+(bL*strlen(cL)), y, (bL+1 == bR ? ! baW.bI[bN] : baW.bI[bN]), cL);
-            } else {
-                // Display item at row count - inverse if start item
-                WPrint(bN, x, y+bL, (bL+1 == bR ? WON : WOFF), cL);
+        // Display each item on first pass
+        if (bP == 0) {
+            for (bL=0; bL<bC; bL++) {
+                MenuI(bN, x, y, bO, bL, (bL+1 == bR), pS[bL]);
+            }
+            bP = bR;
+        }
+        // Else only redraw old and new selection,
+        // skipped while more keys are waiting
+        else if ((bP != bR) && ((bP == XNONE) || (! KeyPend()))) {
+            if (bP != XNONE) {
+                MenuI(bN, x, y, bO, bP-1, FALSE, pS[bP-1]);
             }
+            MenuI(bN, x, y, bO, bR-1, TRUE, pS[bR-1]);
+            bP = bR;
         }
 
         // Get key (no inverse key)
         bK = WaitKCX(WOFF);
 
-        // Process key
-        if ((bK == KDOWN) || (bK == KEQUAL) || (bK == KRIGHT) || (bK == KASTER)) {
+        // Process key, pull-down exits on left/right
+        if ((bO == GPULL) && ((bK == KLEFT) || (bK == KRIGHT))) {
+            bR = (bK == KLEFT ? XLEFT : XRIGHT);
+            bF = TRUE;
+        }
+        else if ((bK == KDOWN) || (bK == KEQUAL) || (bK == KRIGHT) || (bK == KASTER)) {
             // Increment (move down list)
             bR += 1;
 
@@ -95,6 +224,11 @@ byte Menu(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned
                 bR = bC;
             }
         }
+        // Accelerator key, select item and handle as enter
+        else if ((bK < 128) && (cT[bK & 63] != 0)) {
+            bR = cT[bK & 63];
+            bK = KENTER;
+        }
 
         // Set last selected item before checking for ESC/TAB/ENTER
         bL = bR;
@@ -115,17 +249,138 @@ byte Menu(byte bN, byte x, byte y, byte bO, byte bI, byte bS, byte bC, unsigned
         }
     }
 
-    // Uninverse last selection if needed
+    // Uninverse last highlighted item if needed
     if (bI == WOFF) {
-        strcpy(cL, pS[bL-1]);
+        strcpy(cL, pS[bP-1]);
 
         // Unhighlight selection based on orientation
         if (bO == GHORZ) {
-            WPrint(bN, x+((bL-1)*strlen(cL)), y, WOFF, cL);
+            WPrint(bN, x+((bP-1)*strlen(cL)), y, WOFF, cL);
         } else {
-            WPrint(bN, x, y+bL-1, WOFF, cL);
+            WPrint(bN, x, y+bP-1, WOFF, cL);
+        }
+    }
+    // Else move highlight to last selection if not drawn yet
+    else if ((bL != bP) && (bL <= bC)) {
+        MenuI(bN, x, y, bO, bP-1, FALSE, pS[bP-1]);
+        MenuI(bN, x, y, bO, bL-1, TRUE, pS[bL-1]);
+    }
+
+    return(bR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte MenuB(byte bN, byte x, byte y, byte bS, byte bC, unsigned char **pS, td_mpull *pP, byte *pB)
+// Desc...: Horizontal menu bar with pull-down menus
+// Param..: bN = Window handle number of menu bar
+//           x = window column for menu bar
+//           y = window row for menu bar
+//          bS = Start bar item number
+//          bC = Number of bar items
+//          pS = pointer to array of bar item strings (same length)
+//          pP = pointer to array of pull-down descriptors (one per
+//               bar item)
+//          pB = pointer to byte to receive selected bar item #
+// Return.: Selected pull-down item #, ESC (XESC), or TAB (XTAB)
+// Notes..: Pull-down opens under its bar item.  Left/right moves
+//          to the sibling pull-down, ESC returns to the bar.
+//          With a cache, the pull-down image is stored at close
+//          and shown at reopen without redrawing.
+// ------------------------------------------------------------
+byte MenuB(byte bN, byte x, byte y, byte bS, byte bC, unsigned char **pS, td_mpull *pP, byte *pB)
+{
+    byte bF = FALSE, bU = FALSE, bD = TRUE;
+    byte bR, bK, bB, bW, bX, bY, bZ, bL;
+    td_mpull *pM;
+
+    // Set default bar item
+    bB = bS;
+
+    // Continue until finished
+    while (! bF) {
+        // Get bar choice if no pull-down is to be opened
+        if (! bU) {
+            bK = MenuE(bN, x, y, GHORZ, WON, bB, bC, pS, NULL, bD);
+            bD = FALSE;
+
+            // ESC or TAB exit from bar
+            if ((bK == XESC) || (bK == XTAB)) {
+                bR = bK;
+                bF = TRUE;
+            }
+            else {
+                bB = bK;
+                bU = TRUE;
+            }
+        }
+
+        // Open pull-down for bar item
+        if (bU) {
+            pM = &pP[bB-1];
+            if (pM->bS == 0) {
+                pM->bS = 1;
+            }
+
+            // Find pull-down position and size below bar item
+            bZ = strlen(pM->pS[0]) + 2;
+            bX = baW.bX[bN] + x;
+            for (bL = 0; bL < bB-1; bL++) {
+                bX += strlen(pS[bL]);
+            }
+            bY = baW.bY[bN] + y + 1;
+            if (bX + bZ > 40) {
+                bX = 40 - bZ;
+            }
+
+            // Use cached image if there is one
+            if ((pM->cC != NULL) && (pM->bV)) {
+                bW = WOpenI(bX, bY, bZ, pM->bC + 2, WOFF, WON, pM->cC);
+                bK = MenuE(bW, 1, 1, GPULL, WOFF, pM->bS, pM->bC, pM->pS, pM->pK, FALSE);
+            }
+            else {
+                bW = WOpen(bX, bY, bZ, pM->bC + 2, WOFF, WON);
+                bK = MenuE(bW, 1, 1, GPULL, WOFF, pM->bS, pM->bC, pM->pS, pM->pK, TRUE);
+            }
+
+            // Save image to cache before closing
+            if (pM->cC != NULL) {
+                WStore(bW, pM->cC);
+                pM->bV = TRUE;
+            }
+            WClose(bW);
+
+            // Left/right move to sibling pull-down and bar item
+            if ((bK == XLEFT) || (bK == XRIGHT)) {
+                MenuI(bN, x, y, GHORZ, bB-1, FALSE, pS[bB-1]);
+                if (bK == XLEFT) {
+                    bB = (bB == 1 ? bC : bB - 1);
+                }
+                else {
+                    bB = (bB == bC ? 1 : bB + 1);
+                }
+                MenuI(bN, x, y, GHORZ, bB-1, TRUE, pS[bB-1]);
+            }
+            // ESC returns to bar
+            else if (bK == XESC) {
+                bU = FALSE;
+            }
+            // TAB exits
+            else if (bK == XTAB) {
+                bR = XTAB;
+                bF = TRUE;
+            }
+            // Item selected
+            else {
+                pM->bS = bK;
+                bR = bK;
+                bF = TRUE;
+            }
         }
     }
 
+    // Return bar item
+    *pB = bB;
+
     return(bR);
 }
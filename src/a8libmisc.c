@@ -9,13 +9,32 @@
 //          -Type byte is synonymous with unsigned char (a8defines.h)
 // Require: string.h
 // Revised: 2024.12.29 - Added RKC2IKC
+//          2026.10.21 - Added VBI keyboard queue service (KeyQOn,
+//                       KeyQOff), KeyRaw, and KeyPoll.
+//                       WaitKCX and WaitYN read through KeyRaw.
+//          2026.10.22 - Added KeyPend and KeyRep (repeat acceleration).
+//          2026.10.23 - Added joystick and paddle input (KeyDev, KeyJoy),
+//                       and bKSrc key source.
+//          2026.10.24 - IKC2ATA and RKC2IKC use shared const tables.
+//                       Added keymap layers (KeyLayer).
+//          2026.10.25 - Added idle task scheduler (KIdleAdd, KIdleDel,
+//                       KIdleRun).  WaitKCX runs idle tasks.
+//          2026.10.26 - Added keystroke record/replay (KEYREC).
+//          2026.11.14 - Joystick not polled until KeyDev, triggers
+//                       debounced (KJDEB).
+//                       WaitYN reads through WaitKCX.
+//                       KeyJif always built (shared jiffy reader).
+//                       Added KeyPost, replayed keys get keymap
+//                       layer and toggles, records hold key source.
 // --------------------------------------------------
 
 // --------------------------------------------------
 // Includes
 // --------------------------------------------------
 #include "a8defines.h"
+#include "a8defkey.h"
 #include <peekpoke.h>
+#include <stdlib.h>
 
 
 // --------------------------------------------------
@@ -27,6 +46,109 @@ byte WaitYN(byte bD);
 word WaitKCX(byte bI);
 
 
+// --------------------------------------------------
+// Keyboard queue
+// Keys are stored as low byte and high byte (1 for console).
+// Head is read index, tail is write index (VBI).
+// --------------------------------------------------
+byte cKQL[KQSIZE], cKQH[KQSIZE];
+byte bKQHd = 0, bKQTl = 0, bKQCs = KCNON, bKQOn = FALSE;
+word wKQOv, wKQJp;
+
+
+// --------------------------------------------------
+// Key repeat tracking
+// --------------------------------------------------
+word wKRKy = KNONE;
+byte bKRTm = 0, bKRCt = 0;
+
+
+// --------------------------------------------------
+// Joystick/paddle input and key source
+// --------------------------------------------------
+byte bKDev = KDNONE, bKSrc = KSKEY;
+word wKJKy = KNONE;
+byte bKJTm = 0, bKJDl = 0, bKJTg = 1, bKPTg = 1, bKPPs = 0;
+byte bKJTc = 0, bKPTc = 0;
+
+
+// --------------------------------------------------
+// Key translation tables (const, placed in RODATA)
+// --------------------------------------------------
+// Internal key code to ATASCII, 199 for no mapping
+const byte cKIA[192] = {
+    108, 106,  59, 199, 199, 107,  43,  42, 111, 199,
+    112, 117, 155, 105,  45,  61, 118, 199,  99, 199,
+    199,  98, 120, 122,  52, 199,  51,  54, 199,  53,
+     50,  49,  44,  32,  46, 110, 199, 109,  47, 199,
+    114, 199, 101, 121, 199, 116, 119, 113,  57, 199,
+     48,  55, 199,  56,  60,  62, 102, 104, 100, 199,
+    199, 103, 115,  97,  76,  74,  58, 199, 199,  75,
+     92,  94,  79, 199,  80,  85, 199,  73,  95, 124,
+     86, 199,  67, 199, 199,  66,  88,  90,  36, 199,
+     35,  38, 199,  37,  34,  33,  91,  32,  93,  78,
+    199,  77,  63, 199,  82, 199,  69,  89, 199,  84,
+     87,  81,  40, 199,  41,  39, 199,  64, 199, 199,
+     70,  72,  68, 199, 199,  71,  83,  65,  12,  10,
+    123, 199, 199,  11, 199, 199,  15, 199,  16,  21,
+    199,   9, 199, 199,  22, 199,   3, 199, 199,   2,
+     24,  26, 199, 199, 199, 199, 199, 199, 199, 199,
+    199, 199,  96,  14, 199,  13, 199, 199,  18, 199,
+      5,  25, 199,  20,  23,  17, 199, 199, 199, 199,
+    199, 199, 199, 199,   6,   8,   4, 199, 199,   7,
+     19,   1
+};
+
+// Raw scan code to internal key code, 0 for no mapping
+const byte cKRI[192] = {
+    108, 106,  27,   0,   0, 107,  11,  10, 111,   0,
+    112, 117,   0, 105,  13,  29, 118,   0,  99,   0,
+      0,  98, 120, 122,  20,   0,  19,  22,  91,  21,
+     18,  17,  12,   0,  14, 110,   0, 109,  15,   0,
+    114,   0, 101, 121, 127, 116, 119, 113,  25,   0,
+     16,  23, 126,  24,  28,  30, 102, 104, 100,   0,
+      0, 103, 115,  97,  44,  42,  26,   0,   0,  43,
+     60,  62,  47,   0,  48,  53,   0,  41,  63, 124,
+     54,   0,  35,   0,   0,  34,  56,  58,   4,   0,
+      3,   6,   0,   5,   2,   1,  59,   0,  61,  46,
+      0,  45,  31,   0,  50,   0,  37,  57,   0,  52,
+     55,  49,   8,   0,   9,   7,   0,  32, 125,   0,
+     38,  40,  36,   0,   0,  39,  51,  33,  76,  74,
+    123,   0,   0,  75,  94,  95,  79,   0,  80,  85,
+      0,  73,  92,  93,  86,   0,  67,   0,   0,  66,
+     88,  90,   0,   0,   0,   0,   0,   0,   0,   0,
+     64,   0,  96,  78,   0,  77,   0,   0,  82,   0,
+     69,  89,   0,  84,  87,  81,   0,   0,   0,   0,
+      0,   0,   0,   0,  70,  72,  68,   0,   0,  71,
+     83,  65
+};
+
+
+// --------------------------------------------------
+// Keymap layer (KeyLayer)
+// --------------------------------------------------
+const byte *pKLyr = NULL;
+byte bKLFl = KLNONE;
+
+
+// --------------------------------------------------
+// Idle tasks (KIdleAdd)
+// --------------------------------------------------
+void (*pKIFn[KISLOTS])(void);
+byte bKIPr[KISLOTS], bKITm[KISLOTS];
+byte bKINx = 0;
+
+
+#ifdef KEYREC
+// --------------------------------------------------
+// Keystroke record/replay (KeyRec, KeyPlay)
+// --------------------------------------------------
+td_keyrec *pKYBf = NULL;
+word wKYSz = 0, wKYCt = 0, wKYIx = 0, wKYTm = 0;
+byte bKYMd = KYOFF;
+#endif
+
+
 // ------------------------------------------------------------
 // Func...: byte IKC2ATA(byte bS)
 // Desc...: Converts internal key code to ATASCII
@@ -38,40 +160,8 @@ word WaitKCX(byte bI);
 // ------------------------------------------------------------
 byte IKC2ATA(byte bN)
 {
-    byte bR;
-    unsigned char cL[192] = {
-        108, 106,  59, 199, 199, 107,  43,  42, 111, 199,
-        112, 117, 155, 105,  45,  61, 118, 199,  99, 199,
-        199,  98, 120, 122,  52, 199,  51,  54, 199,  53,
-         50,  49,  44,  32,  46, 110, 199, 109,  47, 199,
-        114, 199, 101, 121, 199, 116, 119, 113,  57, 199,
-         48,  55, 199,  56,  60,  62, 102, 104, 100, 199,
-        199, 103, 115,  97,  76,  74,  58, 199, 199,  75,
-         92,  94,  79, 199,  80,  85, 199,  73,  95, 124,
-         86, 199,  67, 199, 199,  66,  88,  90,  36, 199,
-         35,  38, 199,  37,  34,  33,  91,  32,  93,  78,
-        199,  77,  63, 199,  82, 199,  69,  89, 199,  84,
-         87,  81,  40, 199,  41,  39, 199,  64, 199, 199,
-         70,  72,  68, 199, 199,  71,  83,  65,  12,  10,
-        123, 199, 199,  11, 199, 199,  15, 199,  16,  21,
-        199,   9, 199, 199,  22, 199,   3, 199, 199,   2,
-         24,  26, 199, 199, 199, 199, 199, 199, 199, 199,
-        199, 199,  96,  14, 199,  13, 199, 199,  18, 199,
-          5,  25, 199,  20,  23,  17, 199, 199, 199, 199,
-        199, 199, 199, 199,   6,   8,   4, 199, 199,   7,
-         19,   1
-    };
-
-    // Get ATASCII from array if icode<192
-    if (bN < 192) {
-        bR = cL[bN];
-    }
-    // Else dont change it
-    else {
-        bR = bN;
-    }
-
-    return(bR);
+    // Get ATASCII from table if icode<192, else dont change it
+    return(bN < 192 ? cKIA[bN] : bN);
 }
 
 
@@ -85,61 +175,398 @@ byte IKC2ATA(byte bN)
 // Notes..: Does not change if Raw>191
 // ------------------------------------------------------------
 byte RKC2IKC(byte bN)
+{
+    // Get internal from table if rcode<192, else dont change it
+    return(bN < 192 ? cKRI[bN] : bN);
+}
+
+// ------------------------------------------------------------
+// Func...: void KeyQVBI(void)
+// Desc...: Immediate VBI keyboard queue handler
+// Notes..: Assembly only, no C stack use allowed here.
+//          Moves keycode from CH into queue, then queues
+//          console key presses (on press only) and HELP.
+//          Keys stay in CH/HELPFG if queue is full.
+//          Chains to previous VVBLKI vector.
+// ------------------------------------------------------------
+void KeyQVBI(void)
+{
+    // ----- Keyboard -----
+    asm("lda $02FC");
+    asm("cmp #$FF");
+    asm("beq %g", kqcon);
+    asm("ldx %v", bKQTl);
+    asm("sta %v,x", cKQL);
+    asm("lda #$00");
+    asm("sta %v,x", cKQH);
+    asm("inx");
+    asm("txa");
+    asm("and #%b", KQMASK);
+    asm("cmp %v", bKQHd);
+    asm("beq %g", kqcon);
+    asm("sta %v", bKQTl);
+    asm("lda #$FF");
+    asm("sta $02FC");
+
+    // ----- Console, queue on change to pressed -----
+kqcon:
+    asm("lda $D01F");
+    asm("and #$07");
+    asm("cmp %v", bKQCs);
+    asm("beq %g", kqhlp);
+    asm("sta %v", bKQCs);
+    asm("cmp #$07");
+    asm("beq %g", kqhlp);
+    asm("ldx %v", bKQTl);
+    asm("sta %v,x", cKQL);
+    asm("lda #$01");
+    asm("sta %v,x", cKQH);
+    asm("inx");
+    asm("txa");
+    asm("and #%b", KQMASK);
+    asm("cmp %v", bKQHd);
+    asm("beq %g", kqhlp);
+    asm("sta %v", bKQTl);
+
+    // ----- Help -----
+kqhlp:
+    asm("lda $02DC");
+    asm("beq %g", kqend);
+    asm("ldx %v", bKQTl);
+    asm("lda #%b", KFHLP);
+    asm("sta %v,x", cKQL);
+    asm("lda #$00");
+    asm("sta %v,x", cKQH);
+    asm("inx");
+    asm("txa");
+    asm("and #%b", KQMASK);
+    asm("cmp %v", bKQHd);
+    asm("beq %g", kqend);
+    asm("sta %v", bKQTl);
+    asm("lda #$00");
+    asm("sta $02DC");
+
+    // ----- Chain to previous handler -----
+    // Push address-1 and RTS (avoids JMP () page bug)
+kqend:
+    asm("lda %v+1", wKQJp);
+    asm("pha");
+    asm("lda %v", wKQJp);
+    asm("pha");
+    asm("rts");
+}
+
+
+// ------------------------------------------------------------
+// Func...: void KeyQOn(void)
+// Desc...: Starts keyboard queue service
+// Notes..: Called by WInit() when WKEYQ is defined.
+//          Service is removed at program exit.
+//          cc65 kbhit()/cgetc() will not see queued keys.
+// ------------------------------------------------------------
+void KeyQOn(void)
+{
+    // Only install once
+    if (bKQOn == FALSE) {
+        // Empty queue, take current console state
+        bKQHd = 0;
+        bKQTl = 0;
+        bKQCs = PEEK(CONSOL) & 7;
+
+        // Save old vector and set ours (immediate VBI)
+        wKQOv = PEEKW(VVBLKI);
+        wKQJp = wKQOv - 1;
+        asm("ldy #<%v", KeyQVBI);
+        asm("ldx #>%v", KeyQVBI);
+        asm("lda #$06");
+        asm("jsr %w", SETVBV);
+
+        // Set installed and remove at exit
+        bKQOn = TRUE;
+        atexit(KeyQOff);
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void KeyQOff(void)
+// Desc...: Stops keyboard queue service
+// ------------------------------------------------------------
+void KeyQOff(void)
+{
+    // Only if installed
+    if (bKQOn == TRUE) {
+        // Restore old vector
+        asm("ldy %v", wKQOv);
+        asm("ldx %v+1", wKQOv);
+        asm("lda #$06");
+        asm("jsr %w", SETVBV);
+
+        bKQOn = FALSE;
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void KeyDev(byte bD)
+// Desc...: Sets input devices polled along with the keyboard
+// Param..: bD = KDNONE, or KDJOY and/or KDPAD (or'd)
+// Notes..: Default is KDNONE (keyboard only), apps opt in.
+//          Joystick 0 / paddle 0 only.
+// ------------------------------------------------------------
+void KeyDev(byte bD)
+{
+    bKDev = bD;
+
+    // Take current trigger/paddle state so it does not fire at once
+    bKJTg = STRIG0;
+    bKPPs = PADDL0;
+    bKPTg = PTRIG0;
+}
+
+
+// ------------------------------------------------------------
+// Func...: word KeyJoy(void)
+// Desc...: Gets joystick or paddle input as a keycode
+// Return.: KUP, KDOWN, KLEFT, KRIGHT, KENTER, or KNONE
+// Notes..: Stick press reports at once, then repeats after
+//          KJDLY jiffies every KJRPT jiffies while held.
+//          Triggers report on press only, after being
+//          released KJDEB jiffies (debounce).
+//          Paddle reports KUP/KDOWN per KPSTEP of movement.
+//          Sets bKSrc to KSJOY or KSPAD.
+// ------------------------------------------------------------
+word KeyJoy(void)
+{
+    word cR = KNONE, wK = KNONE;
+    byte bS, bT;
+
+    if (bKDev & KDJOY) {
+        // Trigger, on press after a steady release
+        bT = STRIG0;
+        if (bT != bKJTg) {
+            if ((bT == 0) && ((byte) (RTC3 - bKJTc) >= KJDEB)) {
+                cR = KENTER;
+            }
+            bKJTc = RTC3;
+            bKJTg = bT;
+        }
+
+        // Stick direction (bit clear when pushed)
+        bS = STICK0;
+        if ((bS & 1) == 0) {
+            wK = KUP;
+        }
+        else if ((bS & 2) == 0) {
+            wK = KDOWN;
+        }
+        else if ((bS & 4) == 0) {
+            wK = KLEFT;
+        }
+        else if ((bS & 8) == 0) {
+            wK = KRIGHT;
+        }
+
+        // Released
+        if (wK == KNONE) {
+            wKJKy = KNONE;
+        }
+        // New direction, report now and set repeat delay
+        else if (wK != wKJKy) {
+            wKJKy = wK;
+            bKJTm = RTC3;
+            bKJDl = KJDLY;
+            cR = wK;
+        }
+        // Held, report at repeat rate
+        else if ((byte) (RTC3 - bKJTm) >= bKJDl) {
+            bKJTm = RTC3;
+            bKJDl = KJRPT;
+            cR = wK;
+        }
+
+        if (cR != KNONE) {
+            bKSrc = KSJOY;
+        }
+    }
+
+    if ((cR == KNONE) && (bKDev & KDPAD)) {
+        // Paddle trigger, on press after a steady release
+        bT = PTRIG0;
+        if (bT != bKPTg) {
+            if ((bT == 0) && ((byte) (RTC3 - bKPTc) >= KJDEB)) {
+                cR = KENTER;
+            }
+            bKPTc = RTC3;
+            bKPTg = bT;
+        }
+
+        // Paddle movement
+        bS = PADDL0;
+        if (cR == KNONE) {
+            if (bS >= bKPPs + KPSTEP) {
+                cR = KUP;
+                bKPPs = bS;
+            }
+            else if (bS + KPSTEP <= bKPPs) {
+                cR = KDOWN;
+                bKPPs = bS;
+            }
+        }
+
+        if (cR != KNONE) {
+            bKSrc = KSPAD;
+        }
+    }
+
+    return(cR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: word KeyRaw(void)
+// Desc...: Gets next raw key, console, help, or joystick press
+// Return.: keycode, console value + 256, KFHLP,
+//          or KNONE if nothing pressed
+// Notes..: Reads keyboard queue if service is on, else the
+//          hardware/OS registers (and debounces them).
+//          Polls joystick/paddle (see KeyDev) if no key.
+//          Sets bKSrc to source of key.
+// ------------------------------------------------------------
+word KeyRaw(void)
+{
+    word cR = KNONE;
+    byte bC;
+
+    // Take from queue if service is on
+    if (bKQOn == TRUE) {
+        if (bKQHd != bKQTl) {
+            cR = (cKQH[bKQHd] << 8) | cKQL[bKQHd];
+            bKQHd = (bKQHd + 1) & KQMASK;
+
+            // Set source
+            if (cR > 255) {
+                bKSrc = KSCON;
+            }
+            else {
+                bKSrc = (cR == KFHLP ? KSHLP : KSKEY);
+            }
+        }
+    }
+    else {
+        bC = PEEK(CONSOL);
+
+        // Process console key, debounce CONSOL
+        if (bC != KCNON) {
+            cR = bC + 256;
+            POKE(CONSOL, 8);
+            bKSrc = KSCON;
+        }
+        // Process help key, must debounce
+        else if (PEEK(HELPFG) > 0) {
+            cR = KFHLP;
+            POKE(HELPFG, 0);
+            bKSrc = KSHLP;
+        }
+        // Process key, debounce
+        else if (PEEK(KEYPCH) != KNONE) {
+            cR = PEEK(KEYPCH);
+            POKE(KEYPCH, KNONE);
+            bKSrc = KSKEY;
+        }
+    }
+
+    // Nothing from keyboard, try joystick/paddle
+    if ((cR == KNONE) && (bKDev != KDNONE)) {
+        cR = KeyJoy();
+    }
+
+    return(cR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte KeyPend(void)
+// Desc...: Tests if a key press is waiting
+// Return.: TRUE if waiting, else FALSE
+// Notes..: Gadgets use this to skip redraws while keys are
+//          still coming (held keys), drawing only the last.
+// ------------------------------------------------------------
+byte KeyPend(void)
 {
     byte bR;
-    unsigned char cL[192] = {
-        108, 106,  27,   0,   0, 107,  11,  10, 111,   0,
-        112, 117,   0, 105,  13,  29, 118,   0,  99,   0,
-          0,  98, 120, 122,  20,   0,  19,  22,  91,  21,
-         18,  17,  12,   0,  14, 110,   0, 109,  15,   0,
-        114,   0, 101, 121, 127, 116, 119, 113,  25,   0,
-         16,  23, 126,  24,  28,  30, 102, 104, 100,   0,
-          0, 103, 115,  97,  44,  42,  26,   0,   0,  43,
-         60,  62,  47,   0,  48,  53,   0,  41,  63, 124,
-         54,   0,  35,   0,   0,  34,  56,  58,   4,   0,
-          3,   6,   0,   5,   2,   1,  59,   0,  61,  46,
-          0,  45,  31,   0,  50,   0,  37,  57,   0,  52,
-         55,  49,   8,   0,   9,   7,   0,  32, 125,   0,
-         38,  40,  36,   0,   0,  39,  51,  33,  76,  74,
-        123,   0,   0,  75,  94,  95,  79,   0,  80,  85,
-          0,  73,  92,  93,  86,   0,  67,   0,   0,  66,
-         88,  90,   0,   0,   0,   0,   0,   0,   0,   0,
-         64,   0,  96,  78,   0,  77,   0,   0,  82,   0,
-         69,  89,   0,  84,  87,  81,   0,   0,   0,   0,
-          0,   0,   0,   0,  70,  72,  68,   0,   0,  71,
-         83,  65
-    };
-
-    // Get internal from array if rcode<192
-    if (bN < 192) {
-        bR = cL[bN];
-    }
-    // Else dont change it
+
+    // Check queue if service is on, else CH
+    if (bKQOn == TRUE) {
+        bR = (bKQHd != bKQTl);
+    }
     else {
-        bR = bN;
+        bR = (PEEK(KEYPCH) != KNONE);
+    }
+
+    return(bR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte KeyRep(word wK)
+// Desc...: Tracks held key repeats for acceleration
+// Param..: wK = key just received (from WaitKCX)
+// Return.: KRSLOW, KRMED, or KRFAST
+// Notes..: Same key again within KRGAP jiffies (RTC3) counts
+//          as a repeat.  Any other key or a pause resets.
+// ------------------------------------------------------------
+byte KeyRep(word wK)
+{
+    byte bR = KRSLOW;
+    byte bT;
+
+    // Get jiffy clock
+    bT = RTC3;
+
+    // Count repeat if same key soon enough, else restart
+    if ((wK == wKRKy) && ((byte) (bT - bKRTm) < KRGAP)) {
+        if (bKRCt < 255) {
+            bKRCt++;
+        }
+    }
+    else {
+        bKRCt = 0;
+    }
+
+    // Save key and time
+    wKRKy = wK;
+    bKRTm = bT;
+
+    // Set acceleration level
+    if (bKRCt >= KRLVL2) {
+        bR = KRFAST;
+    }
+    else if (bKRCt >= KRLVL1) {
+        bR = KRMED;
     }
 
     return(bR);
 }
 
+
 // ------------------------------------------------------------
 // Func...: byte WaitYN(byte bD)
 // Desc...: Waits for Y or N keypress
 // Param..: bD = WON to print Y or N, or WOFF for no echo
 // Return.: 1=Yes, 0=No
+// Notes..: Reads through WaitKCX (queue, layers, idle tasks,
+//          record/replay).
 // ------------------------------------------------------------
 byte WaitYN(byte bD)
 {
-    byte bR = 0, bK = 0;
+    byte bR = 0;
+    word bK = 0;
 
     // Loop until keypress matches yYnN
     do {
         // Wait for keypress
-        while (! kbhit()) {};
-
-        // Get keypress and debounce
-        bK = PEEK(KEYPCH);
-        POKE(KEYPCH, KNONE);
+        bK = WaitKCX(WOFF);
     } while ((bK != 43) && (bK != 107) && (bK != 35) && (bK != 99));
 
     // If Yy then set return 1
@@ -163,47 +590,56 @@ byte WaitYN(byte bD)
 
 
 // ------------------------------------------------------------
-// Func...: word WaitKCX(byte bI)
-// Desc...: Waits for any key, console, or help key press.
-// Param..: bI = WON to allow inverse toggle, else WOFF.
-// Return.: keycode pressed
-// Notes..: XL/XE only
+// Func...: void KeyLayer(const byte *pL, byte bF)
+// Desc...: Sets keymap layer applied to keys from KeyPoll
+// Param..: pL = pointer to 192 byte keycode remap table,
+//               or NULL for none
+//          bF = KLNONE, or KLSWAP to swap Ctrl and Shift
+// Notes..: Table is used in place (not copied), so it must
+//          stay valid while set.  Swap is applied first.
+//          Only keycodes <192 are remapped.
 // ------------------------------------------------------------
-word WaitKCX(byte bI)
+void KeyLayer(const byte *pL, byte bF)
 {
-    word cR = 0;
-    byte bK, bC, bH, bU;
+    pKLyr = pL;
+    bKLFl = bF;
+}
 
-    // Wait for one of the keys
-    while((PEEK(KEYPCH) == KNONE) && (PEEK(CONSOL) == KCNON) && (PEEK(HELPFG) == 0)) {}
 
-    // Grab the register values
-    bK = PEEK(KEYPCH);
-    bC = PEEK(CONSOL);
-    bH = PEEK(HELPFG);
+// ------------------------------------------------------------
+// Func...: word KeyPost(word cR, byte bI)
+// Desc...: Applies keymap layer and CAPS/inverse toggles
+// Param..: cR = keycode from KeyRaw (or replay script)
+//          bI = WON to allow inverse toggle, else WOFF.
+// Return.: keycode after keymap layer
+// Notes..: Layer only applies when bKSrc is KSKEY.
+// ------------------------------------------------------------
+word KeyPost(word cR, byte bI)
+{
+    byte bU;
 
-    // Process console key
-    if (bC != KCNON) {
-        cR = bC + 256;
-    }
-    // Process help key, must debounce
-    else if (bH > 0) {
-        cR = KFHLP;
-        POKE(HELPFG, 0);
+    // Apply keymap layer to keyboard keys
+    if ((cR < 192) && (bKSrc == KSKEY)) {
+        // Swap Ctrl (bit 7) and Shift (bit 6) if only one is set
+        if ((bKLFl & KLSWAP) && (cR & 0xC0)) {
+            cR ^= 0xC0;
+        }
+
+        // App remap table
+        if (pKLyr != NULL) {
+            cR = pKLyr[cR];
+        }
     }
-    // Toggle CAPS
-    else if (bK == KCAP) {
-        cR = bK;
 
+    // Toggle CAPS
+    if (cR == KCAP) {
         // Get current reg value, flip it, and put it back.
         bU = PEEK(SHFLOK);
         bU ^= 64;
         POKE(SHFLOK, bU);
     }
     // Toggle Inverse
-    else if (bK == KINV) {
-        cR = bK;
-
+    else if (cR == KINV) {
         // Toggle if allowed
         if (bI == WON) {
             // Get current reg value, flip it, and put it back.
@@ -212,16 +648,299 @@ word WaitKCX(byte bI)
             POKE(INVFLG, bU);
         }
     }
-    // All else
-    else {
-        cR = bK;
+
+    return(cR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: word KeyPoll(byte bI)
+// Desc...: Gets any key, console, or help key press if waiting.
+// Param..: bI = WON to allow inverse toggle, else WOFF.
+// Return.: keycode pressed, or KNONE if none
+// Notes..: XL/XE only.  Does not wait.
+// ------------------------------------------------------------
+word KeyPoll(byte bI)
+{
+    return(KeyPost(KeyRaw(), bI));
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte KIdleAdd(void (*pF)(void), byte bP)
+// Desc...: Adds an idle task run while waiting for keys
+// Param..: pF = pointer to task function
+//          bP = period in jiffies (0 for every idle pass)
+// Return.: task slot, or KINONE if no slot free
+// Notes..: Tasks must be short (well under a frame) and
+//          must not wait for keys themselves.
+// ------------------------------------------------------------
+byte KIdleAdd(void (*pF)(void), byte bP)
+{
+    byte bR = KINONE, bL;
+
+    // Find first free slot
+    for (bL=0; bL < KISLOTS; bL++) {
+        if (pKIFn[bL] == NULL) {
+            pKIFn[bL] = pF;
+            bKIPr[bL] = bP;
+            bKITm[bL] = RTC3;
+            bR = bL;
+            break;
+        }
+    }
+
+    return(bR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void KIdleDel(byte bS)
+// Desc...: Removes an idle task
+// Param..: bS = task slot from KIdleAdd
+// ------------------------------------------------------------
+void KIdleDel(byte bS)
+{
+    if (bS < KISLOTS) {
+        pKIFn[bS] = NULL;
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte KIdleRun(void)
+// Desc...: Runs the next due idle task, if any
+// Return.: TRUE if a task ran, else FALSE
+// Notes..: Runs at most one task per call so input is
+//          polled between tasks.  Slots are checked round
+//          robin so one busy task cannot starve the rest.
+// ------------------------------------------------------------
+byte KIdleRun(void)
+{
+    byte bR = FALSE, bL, bS;
+
+    // Check each slot once, starting after the last one run
+    for (bL=0; bL < KISLOTS; bL++) {
+        bS = bKINx;
+        bKINx = (bKINx + 1) % KISLOTS;
+
+        // Run task if its period has passed
+        if ((pKIFn[bS] != NULL) && ((byte) (RTC3 - bKITm[bS]) >= bKIPr[bS])) {
+            bKITm[bS] = RTC3;
+            pKIFn[bS]();
+            bR = TRUE;
+            break;
+        }
+    }
+
+    return(bR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: word KeyJif(void)
+// Desc...: Gets low word of the jiffy clock
+// Return.: jiffy count
+// Notes..: Rereads if the VBI changed it mid read.
+//          Shared jiffy reader for all libraries.
+// ------------------------------------------------------------
+word KeyJif(void)
+{
+    byte bH, bL;
+
+    do {
+        bH = RTC2;
+        bL = RTC3;
+    } while (bH != RTC2);
+
+    return((bH << 8) | bL);
+}
+
+
+#ifdef KEYREC
+// ------------------------------------------------------------
+// Func...: void KeyRec(td_keyrec *pB, word wS)
+// Desc...: Starts recording keys returned by WaitKCX
+// Param..: pB = pointer to record buffer
+//          wS = size of buffer in records
+// Notes..: Each record is the raw keycode, its source, and
+//          jiffies since the previous key.  Recording stops
+//          when buffer fills.
+// ------------------------------------------------------------
+void KeyRec(td_keyrec *pB, word wS)
+{
+    pKYBf = pB;
+    wKYSz = wS;
+    wKYCt = 0;
+    wKYTm = KeyJif();
+    bKYMd = KYREC;
+}
+
+
+// ------------------------------------------------------------
+// Func...: void KeyPlay(td_keyrec *pB, word wC, byte bP)
+// Desc...: Starts replaying recorded keys into WaitKCX
+// Param..: pB = pointer to record buffer
+//          wC = count of records
+//          bP = TRUE to replay at recorded pace,
+//               FALSE for full speed
+// Notes..: Keyboard is used again when replay ends.
+// ------------------------------------------------------------
+void KeyPlay(td_keyrec *pB, word wC, byte bP)
+{
+    pKYBf = pB;
+    wKYCt = wC;
+    wKYIx = 0;
+    wKYTm = KeyJif();
+    bKYMd = (bP ? KYPACE : KYPLAY);
+}
+
+
+// ------------------------------------------------------------
+// Func...: word KeyStop(void)
+// Desc...: Stops recording or replay
+// Return.: number of records recorded (or in replay script)
+// ------------------------------------------------------------
+word KeyStop(void)
+{
+    bKYMd = KYOFF;
+
+    return(wKYCt);
+}
+
+
+// ------------------------------------------------------------
+// Func...: byte KeySave(char *pF)
+// Desc...: Saves recorded keys to a file
+// Param..: pF = file spec (ie "D1:KEYS.REC")
+// Return.: TRUE if saved, else FALSE
+// Notes..: Requires stdio.h.  Saves the last recording.
+// ------------------------------------------------------------
+byte KeySave(char *pF)
+{
+    byte bR = FALSE;
+    FILE *pH;
+
+    // Open file and write records
+    pH = fopen(pF, "wb");
+    if (pH != NULL) {
+        if (fwrite(pKYBf, sizeof(td_keyrec), wKYCt, pH) == wKYCt) {
+            bR = TRUE;
+        }
+        fclose(pH);
+    }
+
+    return(bR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: word KeyLoad(char *pF, td_keyrec *pB, word wS)
+// Desc...: Loads recorded keys from a file
+// Param..: pF = file spec (ie "D1:KEYS.REC")
+//          pB = pointer to record buffer
+//          wS = size of buffer in records
+// Return.: number of records loaded, 0 on error
+// Notes..: Requires stdio.h.  Pass count to KeyPlay.
+// ------------------------------------------------------------
+word KeyLoad(char *pF, td_keyrec *pB, word wS)
+{
+    word wR = 0;
+    FILE *pH;
+
+    // Open file and read records
+    pH = fopen(pF, "rb");
+    if (pH != NULL) {
+        wR = fread(pB, sizeof(td_keyrec), wS, pH);
+        fclose(pH);
     }
 
-    // Debounce CONSOL
-    POKE(CONSOL, 8);
+    return(wR);
+}
+
+
+// ------------------------------------------------------------
+// Func...: word KeyNext(void)
+// Desc...: Gets next key from replay script
+// Return.: raw keycode (before KeyPost)
+// Notes..: Paced replay waits for the recorded gap, running
+//          idle tasks meanwhile.  Ends replay after last key.
+//          Sets bKSrc to the recorded key source.
+// ------------------------------------------------------------
+word KeyNext(void)
+{
+    word cR = KNONE;
+
+    // Wait for recorded gap if pacing
+    if (bKYMd == KYPACE) {
+        while ((word) (KeyJif() - wKYTm) < pKYBf[wKYIx].wT) {
+            KIdleRun();
+        }
+        wKYTm = KeyJif();
+    }
 
-    // Debounce key
-    POKE(KEYPCH, KNONE);
+    // Get key, end replay after last
+    cR = pKYBf[wKYIx].wK;
+    bKSrc = pKYBf[wKYIx].bS;
+    wKYIx++;
+    if (wKYIx >= wKYCt) {
+        bKYMd = KYOFF;
+    }
 
     return(cR);
 }
+#endif
+
+
+// ------------------------------------------------------------
+// Func...: word WaitKCX(byte bI)
+// Desc...: Waits for any key, console, or help key press.
+// Param..: bI = WON to allow inverse toggle, else WOFF.
+// Return.: keycode pressed
+// Notes..: XL/XE only
+//          Runs idle tasks (KIdleAdd) while waiting.
+//          With KEYREC defined, records keys or replays them
+//          (KeyRec, KeyPlay).
+// ------------------------------------------------------------
+word WaitKCX(byte bI)
+{
+    word cR = KNONE;
+
+#ifdef KEYREC
+    // Take raw key from replay script
+    if ((bKYMd == KYPLAY) || (bKYMd == KYPACE)) {
+        if (wKYIx < wKYCt) {
+            cR = KeyNext();
+        }
+        else {
+            bKYMd = KYOFF;
+        }
+    }
+#endif
+
+    // Wait for one of the keys, run an idle task between polls
+    if (cR == KNONE) {
+        while ((cR = KeyRaw()) == KNONE) {
+            KIdleRun();
+        }
+
+#ifdef KEYREC
+        // Record raw key and source with gap since previous key
+        if ((bKYMd == KYREC) && (wKYCt < wKYSz)) {
+            pKYBf[wKYCt].wK = cR;
+            pKYBf[wKYCt].bS = bKSrc;
+            pKYBf[wKYCt].wT = KeyJif() - wKYTm;
+            wKYTm += pKYBf[wKYCt].wT;
+
+            // Clamp long gaps (or clock set back) for paced replay
+            if (pKYBf[wKYCt].wT > KYGMAX) {
+                pKYBf[wKYCt].wT = KYGMAX;
+            }
+            wKYCt++;
+        }
+#endif
+    }
+
+    // Keymap layer and toggles, same for replayed keys
+    return(KeyPost(cR, bI));
+}
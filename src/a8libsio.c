@@ -0,0 +1,439 @@
+// --------------------------------------------------
+// Library: a8libsio.c
+// Desc...: Atari 8 Bit SIO Library
+// Author.: Wade Ripkowski
+// Date...: 2026.11
+// License: GNU General Public License v3.0
+// Note...: Requires: a8defines.h, a8defsio.h, a8defkey.h,
+//                    a8libmisc.c (KeyJif)
+//          -All device libraries (FujiNet, ApeTime) call SIO
+//           through SIOCall, which applies the timeout, retry,
+//           and backoff policy of the call class.
+//          -A device unit that times out on a status or probe
+//           call is not called again for SIOABSTM jiffies
+//           (about 4 seconds).  The first slow call to a device
+//           unit is preceded by a short probe.
+//          -SIOReq sets the DCB from a const template in one
+//           block copy, then patches the variable fields.
+//          -With SIO_STATS defined, keeps count, bytes, latency,
+//           and errors per device/command, read with
+//           SIOStatsGet (fujidemo shows them in a window).
+// Revised: 2026.11.04-Added SIO_STATS metrics.
+//          2026.11.05-Added SIOReq (DCB templates).
+//          2026.11.11-Latency measured from the VBI (SIOVPos).
+//                     SIOStatsWin clamps values to their columns.
+//                     SIOJif no longer needs SIO_STATS.
+//          2026.11.13-Absent table keyed by device and unit, timed
+//                     by SIOJif.  Timeout marks absent once.
+//                     Added SIOPDATA (no retry) class.
+//          2026.11.14-Only status/probe timeouts mark absent.  First
+//                     slow call probes the device unit (SIOProbe).
+//                     SIOJif removed, timed by KeyJif (a8libmisc.c).
+//                     SIOStatsWin moved to fujidemo (ShowSIO).
+// --------------------------------------------------
+
+#include <atari.h>
+#include <string.h>
+#include <peekpoke.h>
+#include "a8defines.h"
+#include "a8defsio.h"
+#include "a8defkey.h"
+
+
+// --------------------------------------------------
+// Call class policies (may be changed by app)
+// --------------------------------------------------
+td_siopol sSIOPol[SIOPCNT] = {
+    {  2, 1,  3 },      // SIOPFAST - status, config, mode
+    {  5, 2,  6 },      // SIOPNORM - close, query
+    { 15, 1, 30 },      // SIOPSLOW - open, compute
+    {  1, 0,  0 },      // SIOPPROB - device may be absent
+    {  5, 0,  0 }       // SIOPDATA - data read/write, not retried
+};
+
+
+// --------------------------------------------------
+// Absent devices: device ID (0 = free), unit, and time
+// marked (KeyJif)
+// --------------------------------------------------
+unsigned char cSIOAbD[SIOABSN], cSIOAbU[SIOABSN];
+unsigned short iSIOAbT[SIOABSN];
+
+
+// --------------------------------------------------
+// Answered devices: device ID (0 = free), unit, and next
+// entry to replace
+// --------------------------------------------------
+unsigned char cSIOPrD[SIOPRSN], cSIOPrU[SIOPRSN];
+unsigned char bSIOPrN = 0;
+
+
+#ifdef SIO_STATS
+// --------------------------------------------------
+// Metrics table, VCOUNT units per frame (0 until set)
+// --------------------------------------------------
+td_siostat sSIOSt[SIOSTN];
+unsigned char bSIOLpf = 0;
+#endif
+
+
+// -----------------------------------
+// Proc..: unsigned char SIODevAbs(unsigned char bD, unsigned char bU)
+// Desc..: Checks if device unit was found absent recently
+// Params: bD = device ID
+//         bU = unit
+// Return: TRUE if absent, else FALSE
+// Note..: Expired entries are freed.
+// -----------------------------------
+unsigned char SIODevAbs(unsigned char bD, unsigned char bU)
+{
+    unsigned char bL;
+
+    for (bL = 0; bL < SIOABSN; bL++) {
+        if ((cSIOAbD[bL] == bD) && (cSIOAbU[bL] == bU)) {
+            // Still absent
+            if ((word) (KeyJif() - iSIOAbT[bL]) < SIOABSTM) {
+                return TRUE;
+            }
+
+            // Expired, try it again
+            cSIOAbD[bL] = 0;
+        }
+    }
+
+    return FALSE;
+}
+
+
+// -----------------------------------
+// Proc..: void SIODevClr(unsigned char bD)
+// Desc..: Clears absent marks of a device (all units)
+// Params: bD = device ID, 0 for all
+// Note..: Use when the user says a device is now there.
+// -----------------------------------
+void SIODevClr(unsigned char bD)
+{
+    unsigned char bL;
+
+    for (bL = 0; bL < SIOABSN; bL++) {
+        if ((bD == 0) || (cSIOAbD[bL] == bD)) {
+            cSIOAbD[bL] = 0;
+        }
+    }
+}
+
+
+// -----------------------------------
+// Proc..: void SIODevMrk(unsigned char bD, unsigned char bU)
+// Desc..: Marks device unit absent
+// Params: bD = device ID
+//         bU = unit
+// Note..: Takes entry of the same device unit, else first
+//         free entry, else the first entry.
+// -----------------------------------
+void SIODevMrk(unsigned char bD, unsigned char bU)
+{
+    unsigned char bL, bF = 0;
+
+    for (bL = SIOABSN; bL > 0; bL--) {
+        if (cSIOAbD[bL - 1] == 0) {
+            bF = bL - 1;
+        }
+    }
+    for (bL = 0; bL < SIOABSN; bL++) {
+        if ((cSIOAbD[bL] == bD) && (cSIOAbU[bL] == bU)) {
+            bF = bL;
+        }
+    }
+
+    cSIOAbD[bF] = bD;
+    cSIOAbU[bF] = bU;
+    iSIOAbT[bF] = KeyJif();
+
+    // No longer known to answer
+    for (bL = 0; bL < SIOPRSN; bL++) {
+        if ((cSIOPrD[bL] == bD) && (cSIOPrU[bL] == bU)) {
+            cSIOPrD[bL] = 0;
+        }
+    }
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char SIODevOk(unsigned char bD, unsigned char bU)
+// Desc..: Checks if device unit has answered before
+// Params: bD = device ID
+//         bU = unit
+// Return: TRUE if it answered, else FALSE
+// -----------------------------------
+unsigned char SIODevOk(unsigned char bD, unsigned char bU)
+{
+    unsigned char bL;
+
+    for (bL = 0; bL < SIOPRSN; bL++) {
+        if ((cSIOPrD[bL] == bD) && (cSIOPrU[bL] == bU)) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char SIOProbe(void)
+// Desc..: Checks device unit set in DCB answers
+// Return: SIO status of probe (SIOETIME if no answer)
+// Note..: Sends SIOPRCMD (status) with the SIOPPROB timeout
+//         and no retries.  DCB is kept.
+// -----------------------------------
+unsigned char SIOProbe(void)
+{
+    td_siodcb sD;
+    unsigned char cS[4], bS;
+
+    // Keep DCB, set up status read
+    memcpy(&sD, &OS.dcb, sizeof(td_siodcb));
+    OS.dcb.dcomnd = SIOPRCMD;
+    OS.dcb.dstats = DCBREAD;
+    OS.dcb.dbuf   = cS;
+    OS.dcb.dtimlo = sSIOPol[SIOPPROB].bT;
+    OS.dcb.dbyt   = 4;
+    OS.dcb.daux   = 0;
+
+    // Call SIO, put DCB back
+    SIOV();
+    bS = OS.dcb.dstats;
+    memcpy(&OS.dcb, &sD, sizeof(td_siodcb));
+
+    return bS;
+}
+
+
+// -----------------------------------
+// Proc..: unsigned char SIOCall(unsigned char bP)
+// Desc..: Calls SIO with DCB already set up
+// Params: bP = call class (SIOPFAST, SIOPNORM, SIOPSLOW,
+//              SIOPPROB, SIOPDATA)
+// Return: SIO status (SIOOK = Success)
+// Note..: Sets DCB timeout from class.  Retries transient
+//         errors (NAK, framing, overrun, checksum) after
+//         the class backoff.  A timeout of a status or probe
+//         call (SIOPFAST, SIOPPROB) marks the device unit
+//         absent so following calls fail at once.  Before the
+//         first slow call (SIOPSLOW) to a device unit it is
+//         probed, so a missing device costs the probe timeout,
+//         not the slow one.
+//         Data transfers (SIOPDATA) are not retried, a
+//         repeated read or write could skip or double data.
+// -----------------------------------
+unsigned char SIOCall(unsigned char bP)
+{
+    td_siopol *pP = &sSIOPol[bP];
+    unsigned char bS, bD, bR, bT;
+#ifdef SIO_STATS
+    unsigned short iJ, iE;
+    unsigned char bV;
+    long lT;
+
+    // VCOUNT units per frame
+    if (bSIOLpf == 0) {
+        bSIOLpf = ((PEEK(PAL) & 0x0E) == 0 ? 156 : 131);
+    }
+
+    // Start time
+    do {
+        iJ = KeyJif();
+        bV = SIOVPos();
+    } while (iJ != KeyJif());
+#endif
+
+    // Fail at once if device unit is absent
+    if (SIODevAbs(OS.dcb.ddevic, OS.dcb.dunit)) {
+        OS.dcb.dstats = SIOETIME;
+        return SIOETIME;
+    }
+
+    // First slow call, make sure device unit answers
+    if ((bP == SIOPSLOW) && (! SIODevOk(OS.dcb.ddevic, OS.dcb.dunit))) {
+        if (SIOProbe() == SIOETIME) {
+            SIODevMrk(OS.dcb.ddevic, OS.dcb.dunit);
+            OS.dcb.dstats = SIOETIME;
+            return SIOETIME;
+        }
+    }
+
+    // Keep direction for retries, set timeout
+    bD = OS.dcb.dstats;
+    OS.dcb.dtimlo = pP->bT;
+    bR = pP->bR;
+
+    while (TRUE) {
+        // Call SIO
+        SIOV();
+        bS = OS.dcb.dstats;
+
+        // Done on success or no retries left
+        if ((bS == SIOOK) || (bR == 0)) {
+            break;
+        }
+
+        // Device did not answer, dont retry (marked below)
+        if (bS == SIOETIME) {
+            break;
+        }
+
+        // Not transient, dont retry
+        if ((bS != SIOENAK) && (bS != SIOEFRM) && (bS != SIOEOVR) && (bS != SIOECHK)) {
+            break;
+        }
+
+        // Back off, then retry
+        bT = RTC3;
+        while ((byte) (RTC3 - bT) < pP->bB) {}
+        OS.dcb.dstats = bD;
+        bR--;
+    }
+
+    // Status/probe timeout marks device unit absent.  Data
+    // and slow calls may just be waiting on the network.
+    if (bS == SIOETIME) {
+        if ((bP == SIOPFAST) || (bP == SIOPPROB)) {
+            SIODevMrk(OS.dcb.ddevic, OS.dcb.dunit);
+        }
+    }
+    // Any answer, keep as answered
+    else if (! SIODevOk(OS.dcb.ddevic, OS.dcb.dunit)) {
+        cSIOPrD[bSIOPrN] = OS.dcb.ddevic;
+        cSIOPrU[bSIOPrN] = OS.dcb.dunit;
+        bSIOPrN = (bSIOPrN + 1) % SIOPRSN;
+    }
+
+#ifdef SIO_STATS
+    // End time
+    do {
+        iE = KeyJif();
+        lT = SIOVPos();
+    } while (iE != KeyJif());
+
+    // Latency from frames and VCOUNT units since the VBI,
+    // never less than 0 (clock read just before its VBI tick)
+    lT += ((long) (iE - iJ)) * bSIOLpf - bV;
+    SIOStatsAdd(bS, (lT < 0 ? 0 : lT));
+#endif
+
+    return bS;
+}
+
+
+
+// -----------------------------------
+// Proc..: unsigned char SIOReq(const td_siodcb *pT, unsigned char bU, void *pB, unsigned short iS, unsigned short iA)
+// Desc..: Calls SIO from a DCB template
+// Params: pT = pointer to DCB template
+//         bU = unit
+//         pB = buffer
+//         iS = # of bytes
+//         iA = aux (aux1 low byte, aux2 high byte)
+// Return: SIO status (SIOOK = Success)
+// Note..: Uses call class of template (see SIOCall).
+// -----------------------------------
+unsigned char SIOReq(const td_siodcb *pT, unsigned char bU, void *pB, unsigned short iS, unsigned short iA)
+{
+    // Copy template, patch variable fields
+    memcpy(&OS.dcb, pT, sizeof(td_siodcb));
+    OS.dcb.dunit = bU;
+    OS.dcb.dbuf  = pB;
+    OS.dcb.dbyt  = iS;
+    OS.dcb.daux  = iA;
+
+    return SIOCall(pT->bPol);
+}
+
+
+#ifdef SIO_STATS
+// -----------------------------------
+// Proc..: unsigned char SIOVPos(void)
+// Desc..: Gets VCOUNT units since the last vertical blank
+// Return: 0 to bSIOLpf - 1
+// Note..: The jiffy clock ticks at the VBI (VCOUNT SIOVBL),
+//         not when VCOUNT wraps to 0.
+// -----------------------------------
+unsigned char SIOVPos(void)
+{
+    unsigned char bV = VCOUNT;
+
+    return (bV >= SIOVBL ? bV - SIOVBL : bV + bSIOLpf - SIOVBL);
+}
+
+
+// -----------------------------------
+// Proc..: void SIOStatsAdd(unsigned char bS, unsigned long lT)
+// Desc..: Adds a call to the metrics of the DCB device/command
+// Params: bS = SIO status of call
+//         lT = latency (VCOUNT units)
+// Note..: Calls are not counted once the table is full.
+// -----------------------------------
+void SIOStatsAdd(unsigned char bS, unsigned long lT)
+{
+    td_siostat *pS = sSIOSt;
+    unsigned char bL;
+
+    // Find entry for device/command, or a free one
+    for (bL = 0; bL < SIOSTN; bL++, pS++) {
+        if ((pS->bD == OS.dcb.ddevic) && (pS->bC == OS.dcb.dcomnd)) {
+            break;
+        }
+        if (pS->bD == 0) {
+            pS->bD = OS.dcb.ddevic;
+            pS->bC = OS.dcb.dcomnd;
+            break;
+        }
+    }
+
+    if (bL < SIOSTN) {
+        pS->iN++;
+        pS->lT += lT;
+        if (lT > pS->iM) {
+            pS->iM = (lT > 0xFFFF ? 0xFFFF : lT);
+        }
+
+        // Count errors, bytes of good calls
+        if (bS != SIOOK) {
+            pS->iE++;
+        }
+        else {
+            pS->lB += OS.dcb.dbyt;
+        }
+    }
+}
+
+
+// -----------------------------------
+// Proc..: td_siostat *SIOStatsGet(unsigned char *pC)
+// Desc..: Gets metrics table
+// Params: pC = where to put # of entries used
+// Return: pointer to metrics table
+// Note..: Latency is in VCOUNT units, divide by SIOLpf
+//         (bSIOLpf) for jiffies.
+// -----------------------------------
+td_siostat *SIOStatsGet(unsigned char *pC)
+{
+    unsigned char bL;
+
+    for (bL = 0; (bL < SIOSTN) && (sSIOSt[bL].bD != 0); bL++) {}
+    *pC = bL;
+
+    return sSIOSt;
+}
+
+
+// -----------------------------------
+// Proc..: void SIOStatsClr(void)
+// Desc..: Clears metrics table
+// -----------------------------------
+void SIOStatsClr(void)
+{
+    memset(sSIOSt, 0, sizeof(sSIOSt));
+}
+#endif
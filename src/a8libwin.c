@@ -11,6 +11,10 @@
 // Revised: 2024.02-Added borderless window support.
 //          2025.01-Alter WClr to allow specifying top and bottom row.
 //                  Renamed to WClrRw.
+//          2026.10-Added WOpenI to open a window from a stored image.
+//                  WOpen is now a define for WOpenI.
+//                  Added WStore to save a window image.
+//          2026.10-WInit starts keyboard queue if WKEYQ defined.
 // --------------------------------------------------
 
 // --------------------------------------------------
@@ -19,12 +23,14 @@
 #include <peekpoke.h>
 #include "a8defines.h"
 #include "a8defwin.h"
+#include "a8defkey.h"
 
 
 // --------------------------------------------------
 // Defines to preserve backward call compatability.
 // --------------------------------------------------
 #define WClr(a) WClrRw(a,WPTOP,WPBOT)
+#define WOpen(a,b,c,d,e,f) WOpenI(a,b,c,d,e,f,NULL)
 
 
 // --------------------------------------------------
@@ -32,8 +38,9 @@
 // --------------------------------------------------
 void WInit(void);
 void WBack(byte bN);
-byte WOpen(byte x, byte y, byte w, byte h, byte bT, byte bB);
+byte WOpenI(byte x, byte y, byte w, byte h, byte bT, byte bB, unsigned char *pC);
 byte WClose(byte bN);
+byte WStore(byte bN, unsigned char *pC);
 byte WStat(byte bN);
 byte WPos(byte bN, byte x, byte y);
 byte WPut(byte bN, byte x);
@@ -89,6 +96,11 @@ void WInit(void)
     for (bL = 0; bL < 24; bL++) {
       iSMr[bL] = iSM + (bL * 40);
     }
+
+#ifdef WKEYQ
+    // Start keyboard queue service
+    KeyQOn();
+#endif
 }
 
 
@@ -106,7 +118,7 @@ void WBack(byte bN)
 
 
 // --------------------------------------------------
-// Function: byte WOpen(byte x, byte y, byte w, byte h, byte bT, byte b)
+// Function: byte WOpenI(byte x, byte y, byte w, byte h, byte bT, byte b, unsigned char *pC)
 // Desc....: Open a window
 // Param...: x = column
 //           y = row
@@ -116,12 +128,15 @@ void WBack(byte bN)
 //                WON/WOFF
 //           b = border flag
 //               WON/WOFF
+//           pC = pointer to stored window image (see WStore),
+//                or NULL to draw an empty window
 // Returns.: Window handle number
 //           > 100 on error
 // Notes...: cL is not manipulated as a string.
 //           (0) is data, not size.
+//           Image must be from a window of the same size.
 // --------------------------------------------------
-byte WOpen(byte x, byte y, byte w, byte h, byte bT, byte b)
+byte WOpenI(byte x, byte y, byte w, byte h, byte bT, byte b, unsigned char *pC)
 {
     byte bR = WENONE;
     byte bL, bD, bC;
@@ -152,40 +167,47 @@ byte WOpen(byte x, byte y, byte w, byte h, byte bT, byte b)
 
             // Draw window
             for(bD=0; bD <= h-1; bD++) {
-                // Build window line as string (internal char codes)
-                memset(cL, 0, w);
-
-                // If borders are on, define them
-                if (b == WON) {
-                    // If top or bottom line ("+-+")
-                    if ((bD == 0) || (bD == h-1)) {
-                        // Set solid line
-                        memset(cL, 82, w);
-
-                        // Top line corners
-                        if (bD == 0) {
-                            cL[0] = 81;
-                            cL[w-1] = 69;
+                // If image given, take line from it
+                if (pC != NULL) {
+                    memcpy(cL, pC, w);
+                    pC += w;
+                }
+                else {
+                    // Build window line as string (internal char codes)
+                    memset(cL, 0, w);
+
+                    // If borders are on, define them
+                    if (b == WON) {
+                        // If top or bottom line ("+-+")
+                        if ((bD == 0) || (bD == h-1)) {
+                            // Set solid line
+                            memset(cL, 82, w);
+
+                            // Top line corners
+                            if (bD == 0) {
+                                cL[0] = 81;
+                                cL[w-1] = 69;
+                            }
+                            // Bottom line corners
+                            else {
+                                cL[0] = 90;
+                                cL[w-1] = 67;
+                            }
                         }
-                        // Bottom line corners
+                        // Middle line "| |"
                         else {
-                            cL[0] = 90;
-                            cL[w-1] = 67;
-                        }
+                            // Set space and sides
+                            memset(cL, 0, w);
+                            cL[0] = 124;
+                            cL[w-1] = 124;
                         }
-                    // Middle line "| |"
-                    else {
-                        // Set space and sides
-                        memset(cL, 0, w);
-                        cL[0] = 124;
-                        cL[w-1] = 124;
                     }
-                }
 
-                // If inverse flag, flip line
-                if (bT == WON) {
-                    for (bC=0; bC <= w-1; bC++) {
-                        cL[bC] ^= 128;
+                    // If inverse flag, flip line
+                    if (bT == WON) {
+                        for (bC=0; bC <= w-1; bC++) {
+                            cL[bC] ^= 128;
+                        }
                     }
                 }
 
@@ -268,6 +290,44 @@ byte WClose(byte bN)
 }
 
 
+// --------------------------------------------------
+// Function: byte WStore(byte bN, unsigned char *pC)
+// Desc....: Stores window image (frame and contents)
+// Param...: bN = window handle number
+//           pC = pointer to storage (width * height bytes)
+// Returns.: 0 if success
+//           >100 on error
+// Notes...: Pass image to WOpenI to show the window again
+//           without redrawing it.
+// --------------------------------------------------
+byte WStore(byte bN, unsigned char *pC)
+{
+    byte bR = WENOPN;
+    byte bL;
+    word pS;
+
+    // Only if handle in use
+    if (baW.bU[bN] == WON) {
+        // Find top left corner of window in screen memory
+        pS = iSMr[baW.bY[bN]] + baW.bX[bN];
+
+        // Copy screen line by line
+        for (bL=0; bL <= baW.bH[bN]-1; bL++) {
+            memcpy(pC, (char *) pS, baW.bW[bN]);
+            // Inc storage ptr by width
+            pC += baW.bW[bN];
+            // Inc screen by 40 to next line
+            pS += 40;
+        }
+
+        // Set return
+        bR = 0;
+    }
+
+    return(bR);
+}
+
+
 // --------------------------------------------------
 // Function: byte WStat(byte bN)
 // Desc....: Tests if window handle is open
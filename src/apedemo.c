@@ -12,7 +12,10 @@
 #include <conio.h>
 #include <unistd.h>
 
+#include "a8defines.h"
 #include "a8defsio.h"
+#include "a8libmisc.c"
+#include "a8libsio.c"
 #include "a8libape.c"
 
 
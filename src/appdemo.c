@@ -14,6 +14,18 @@
 #include <string.h>
 #include <atari.h>
 
+// Use keyboard queue service (started by WInit)
+#define WKEYQ
+
+// Record this session to D1:DEMO.KEY, or replay it if the
+// file exists (uncomment to use, see main)
+// #define KEYTEST
+
+#ifdef KEYTEST
+// Use keystroke record/replay
+#define KEYREC
+#endif
+
 #include "a8defines.h"
 #include "a8defwin.h"
 #include "a8libmisc.c"
@@ -24,11 +36,19 @@
 
 #define PERF_TEST
 
+#ifdef KEYTEST
+// Keystroke script, replayed if found else recorded
+#define KRFILE "D1:DEMO.KEY"
+#define KRSIZE 256
+td_keyrec sKR[KRSIZE];
+#endif
+
 // Prototypes
 void DoSpin(void);
 byte FormInput(void);
 byte ListInput(void);
 void ProgTest(void);
+void ViewText(void);
 void About(void);
 
 
@@ -45,6 +65,7 @@ byte FormInput(void)
 {
     byte bR = FALSE, bRA = 1, bRB = 1, bChap = GCOFF, bChbp = GCON, bChcp = GCOFF, bV = 10;
     byte bW1, bW2, bM, bA, bB, bC, bD, bVp, bRAp, bRBp, bCha, bChb, bChc, bL = 0;
+    word wJ;
     // Regular buttons, radio buttons, and data field names
     unsigned char *paB[3] = { "[ Ok ]", "[Cancel]" },
                   *prA[4] = { "One", "Two", "Three" },
@@ -72,9 +93,8 @@ byte FormInput(void)
     bRBp = bRB;
     bVp = bV;
 
-    // Reset clock
-    OS.rtclok[1] = 0;
-    OS.rtclok[2] = 0;
+    // Start time (clock is not reset, KEYREC times keys with it)
+    wJ = OS.rtclok[2] + OS.rtclok[1] * 256;
 
     // Open window & draw form
     bW1 = WOpen(2, 4, 36, 18, WOFF, WON);
@@ -134,7 +154,8 @@ byte FormInput(void)
     WClose(bW2);
 
     // Display time it took to draw screen
-    sprintf(cT, "Jiffies: %5d", OS.rtclok[2] + OS.rtclok[1] * 256);
+    wJ = (OS.rtclok[2] + OS.rtclok[1] * 256) - wJ;
+    sprintf(cT, "Jiffies: %5u", wJ);
     GAlert(cT);
     // ----- Performance Test Display End -----
 
@@ -331,6 +352,50 @@ void ProgTest(void)
 }
 
 
+// ------------------------------------------------------------
+// Func...: void ViewText(void)
+// Desc...: Demos GView text viewer.
+// ------------------------------------------------------------
+void ViewText(void)
+{
+    byte bW1;
+    td_view sV;
+    unsigned int iI[64];
+    unsigned char *cT =
+      "GView Text Viewer\n"
+      "-----------------\n"
+      "GView pages and scrolls through text larger than its window.  "
+      "Long lines are wrapped at the view width when indexed.\n\n"
+      "Keys:\n"
+      " Up/Down    - scroll one line\n"
+      " Left/Right - scroll one page\n"
+      " Ctrl-Shft-S/E - start/end\n"
+      " ESC/TAB/RETURN - exit\n\n"
+      "The line index is built once by GVIdx.  Text can be added to "
+      "the buffer in chunks, such as from a network connection, and "
+      "GVIdx called again to index only the new part.\n\n"
+      "Only the visible rows are drawn, straight into screen memory, "
+      "so each keypress costs the same no matter how large the text.\n\n"
+      "Line 1\nLine 2\nLine 3\nLine 4\nLine 5\nLine 6\nLine 7\nLine 8\n"
+      "Line 9\nLine 10\nLine 11\nLine 12\nLine 13\nLine 14\nLine 15\n"
+      "End of text.";
+
+    // Open window
+    bW1 = WOpen(4, 4, 32, 14, WOFF, WON);
+    WOrn(bW1, WPTOP, WPLFT, "Text View");
+
+    // Index the text and view it
+    GVInit(&sV, cT, iI, 64, 30);
+    GVIdx(&sV, strlen(cT));
+    GView(bW1, 1, 1, 12, GEDIT, &sV);
+
+    // Close window
+    WClose(bW1);
+
+    return;
+}
+
+
 // ------------------------------------------------------------
 // Func...: void About(void)
 // Desc...: About Dialog
@@ -415,13 +480,20 @@ void main(void)
     // Variables
     byte bW1, bW2, bC = 1;
     byte bD = FALSE;
-    unsigned char *pcM[7] =
-      { " Input Form   ", " List Input   ", " Progress Bar ", " Sub-Menu     ", " About        ", " Exit         " };
+#ifdef KEYTEST
+    word wC, wT;
+    unsigned char cL[41];
+#endif
+    unsigned char *pcM[8] =
+      { " Input Form   ", " List Input   ", " Progress Bar ", " Sub-Menu     ", " Text View    ", " About        ", " Exit         " };
 
     // Setup screen
     WInit();
     WBack(14);
 
+    // Drive menus and gadgets with joystick 0 too
+    KeyDev(KDJOY);
+
     // Open header window
     bW1 = WOpen(0, 0, 40, 3, WON, WON);
     WPrint(bW1, WPCNT, 1, WON, "D E M O N S T R A T I O N");
@@ -431,14 +503,27 @@ void main(void)
     sleep(2);
     GStat(WOFF, "");
 
+#ifdef KEYTEST
+    // Replay keystroke script at full speed if there is one,
+    // else record this session to make one
+    wC = KeyLoad(KRFILE, sKR, KRSIZE);
+    if (wC > 0) {
+        KeyPlay(sKR, wC, FALSE);
+    }
+    else {
+        KeyRec(sKR, KRSIZE);
+    }
+    wT = KeyJif();
+#endif
+
     // Open menu window
-    bW2 = WOpen(12, 7, 16, 10, WOFF, WON);
+    bW2 = WOpen(12, 7, 16, 11, WOFF, WON);
     WOrn(bW2, WPTOP, WPCNT, "Menu");
 
     // Loop until done (Exit selected)
     while (! bD) {
         // Call menu
-        bC = Menu(bW2, 1, 2, GVERT, WON, bC, 6, pcM);
+        bC = Menu(bW2, 1, 2, GVERT, WON, bC, 7, pcM);
 
         // Process choice
         switch (bC) {
@@ -454,10 +539,13 @@ void main(void)
             case 4: SubMenu();
                     break;
 
-            case 5: About();
+            case 5: ViewText();
+                    break;
+
+            case 6: About();
                     break;
 
-            case 6: if (GConf("Exiting the demo application...") == GCYES) {
+            case 7: if (GConf("Exiting the demo application...") == GCYES) {
                         bD = TRUE;
                     }
                     break;
@@ -469,6 +557,17 @@ void main(void)
         }
     }
 
+#ifdef KEYTEST
+    // Show session time, save recording
+    wT = KeyJif() - wT;
+    if (wC == 0) {
+        wC = KeyStop();
+        KeySave(KRFILE);
+    }
+    sprintf(cL, "%u keys in %u jiffies", wC, wT);
+    GAlert(cL);
+#endif
+
     // Close windows
     WClose(bW2);
     WClose(bW1);
@@ -16,6 +16,9 @@
 #include <fcntl.h>
 #include <atari.h>
 
+// Keep SIO metrics (SIO Stats menu item)
+#define SIO_STATS
+
 #include "a8defines.h"
 #include "a8defwin.h"
 #include "a8defsio.h"
@@ -24,9 +27,13 @@
 #include "a8libwin.c"
 #include "a8libgadg.c"
 #include "a8libmenu.c"
+#include "a8libsio.c"
 #include "a8libfuji.c"
+#include "a8libb64.c"
 #include "a8libfujib64.c"
 #include "a8libfujihash.c"
+#include "a8libhash.c"
+#include "a8libfujistm.c"
 
 
 // Prototypes
@@ -35,10 +42,17 @@ void TestCfg(void);
 void TestCon(void);
 void TestB64(void);
 void TestHash(void);
+void BenchB64(void);
+void BenchHash(void);
+void ShowSIO(void);
+
 
+// Base64 bench piece size (whole groups, fits cBI/cBO)
+#define B64BLK 255
 
 // Globals
 static unsigned char cU[256] = "N:HTTP://68k.news:80/";
+static unsigned char cBI[256], cBO[345];
 
 
 // ------------------------------------------------------------
@@ -133,13 +147,10 @@ void TestCfg(void)
 void TestCon(void)
 {
     byte bW;
-    unsigned char *cB;
     unsigned char cL[37];
     unsigned char bS = 0, bL = 0;
 
-    // Get some memory and clear it
-    cB = malloc(768);
-    memset(cB, 0, 767);
+    // Clear memory
     memset(cL, 0, 36);
 
     // Open window
@@ -163,11 +174,18 @@ void TestCon(void)
         GAlert("Connect: Failed to open!");
     }
 
-    // Get data
-    bS = FNRead(598, cB);
+    // Get and display lines until window is full or connection ends
+    FNStreamInit();
+    for (bL = 0; bL < 16; bL ++) {
+        // Stop at end of stream or no data (FNSEOF/FNSTIME)
+        if (FNReadLine(1, cL, 37) < 0) {
+            break;
+        }
+        WPrint(bW, 1, 3 + bL, WOFF, cL);
+    }
 
     // Check status and report
-    if (bS != FNSOK) {
+    if (bL == 0) {
         GAlert("Connect: Failed to read!");
     }
 
@@ -179,20 +197,11 @@ void TestCon(void)
         GAlert("Connect: Failed to close!");
     }
 
-    // Display data
-    for (bL = 0; bL < 16; bL ++) {
-        strncpy(cL, cB + (bL * 36), 36);
-        WPrint(bW, 1, 3 + bL, WOFF, cL);
-    }
-
     // Wait for key
     WaitKCX(WOFF);
 
     // Close window
     WClose(bW);
-
-    // Free memory
-    free(cB);
 }
 
 
@@ -360,6 +369,182 @@ void TestHash(void)
 }
 
 
+// ------------------------------------------------------------
+// Func...: void BenchB64(void)
+// Desc...: Times Base64 encode, local vs FujiNet, for input
+//          sizes up to 4K (2 runs each, in jiffies).
+// Notes..: Input is sent, and output read, in B64BLK byte
+//          pieces (the FujiNet appends input), so larger
+//          sizes need no larger buffers.  Local encodes the
+//          same pieces.
+// ------------------------------------------------------------
+void BenchB64(void)
+{
+    unsigned short iZ[4] = { 64, 256, 1024, 4096 };
+    unsigned short iJ, iL, iF, iK, iN;
+    unsigned long lL;
+    unsigned char cL[33];
+    byte bW, bL, bR;
+
+    // Fill input
+    for (iL = 0; iL < 256; iL++) {
+        cBI[iL] = iL;
+    }
+
+    // Open output window
+    bW = WOpen(5, 6, 30, 10, WOFF, WON);
+    WOrn(bW, WPTOP, WPLFT, "B64 Bench");
+    WPrint(bW, 1, 1, WOFF, "Size  Local  FujiNet");
+    WDiv(bW, 7, WON);
+    WPrint(bW, WPCNT, 8, WON, " Ok ");
+
+    for (bL = 0; bL < 4; bL++) {
+        // Local
+        iJ = KeyJif();
+        for (bR = 0; bR < 2; bR++) {
+            for (iK = iZ[bL]; iK > 0; iK -= iN) {
+                iN = (iK > B64BLK ? B64BLK : iK);
+                B64Enc(cBI, iN, cBO);
+            }
+        }
+        iL = KeyJif() - iJ;
+
+        // FujiNet
+        iJ = KeyJif();
+        for (bR = 0; bR < 2; bR++) {
+            for (iK = iZ[bL]; iK > 0; iK -= iN) {
+                iN = (iK > B64BLK ? B64BLK : iK);
+                FNB64Inp(FNLENCODE, cBI, iN);
+            }
+            FNB64Cmp(FNLENCODE);
+            FNB64Len(FNLENCODE, &lL);
+            for (; lL > 0; lL -= iN) {
+                iN = (lL > sizeof(cBO) ? sizeof(cBO) : lL);
+                if (FNB64Out(FNLENCODE, cBO, iN) != FNSOK) {
+                    break;
+                }
+            }
+        }
+        iF = KeyJif() - iJ;
+
+        // Show times
+        sprintf(cL, "%4u  %5u  %7u", iZ[bL], iL, iF);
+        WPrint(bW, 1, bL + 2, WOFF, cL);
+    }
+
+    // Wait for key
+    WaitKCX(WOFF);
+
+    // Close window
+    WClose(bW);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void BenchHash(void)
+// Desc...: Times local SHA1 and CRC32 against FujiNet SHA1
+//          for a few input sizes (4 runs each, in jiffies).
+// ------------------------------------------------------------
+void BenchHash(void)
+{
+    unsigned short iZ[4] = { 16, 64, 128, 256 };
+    unsigned short iJ, iS, iC, iF;
+    unsigned char cL[33];
+    byte bW, bL, bR;
+
+    // Fill input
+    for (iJ = 0; iJ < 256; iJ++) {
+        cBI[iJ] = iJ;
+    }
+
+    // Open output window
+    bW = WOpen(5, 6, 30, 10, WOFF, WON);
+    WOrn(bW, WPTOP, WPLFT, "Hash Bench");
+    WPrint(bW, 1, 1, WOFF, "Size  SHA1  CRC32  FujiNet");
+    WDiv(bW, 7, WON);
+    WPrint(bW, WPCNT, 8, WON, " Ok ");
+
+    for (bL = 0; bL < 4; bL++) {
+        // Local SHA1
+        iJ = KeyJif();
+        for (bR = 0; bR < 4; bR++) {
+            HashLocal(FNHASHSHA1, FNHASHOBIN, cBI, iZ[bL], cBO);
+        }
+        iS = KeyJif() - iJ;
+
+        // Local CRC32
+        iJ = KeyJif();
+        for (bR = 0; bR < 4; bR++) {
+            HashLocal(FNHASHCRC, FNHASHOBIN, cBI, iZ[bL], cBO);
+        }
+        iC = KeyJif() - iJ;
+
+        // FujiNet SHA1
+        iJ = KeyJif();
+        for (bR = 0; bR < 4; bR++) {
+            FNHashInp(cBI, iZ[bL]);
+            FNHashCmp(FNHASHSHA1);
+            FNHashOut(FNHASHSHA1, FNHASHOBIN, cBO);
+        }
+        iF = KeyJif() - iJ;
+
+        // Show times
+        sprintf(cL, "%4u  %4u  %5u  %7u", iZ[bL], iS, iC, iF);
+        WPrint(bW, 1, bL + 2, WOFF, cL);
+    }
+
+    // Wait for key
+    WaitKCX(WOFF);
+
+    // Close window
+    WClose(bW);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void ShowSIO(void)
+// Desc...: Shows SIO metrics table (SIOStatsGet) in a window
+// Notes..: Latency shown in jiffies (average and max).
+//          Values too wide for their column are shown at
+//          the column maximum.
+// ------------------------------------------------------------
+void ShowSIO(void)
+{
+    td_siostat *pS;
+    byte bW, bC, bL, bP;
+    unsigned long lA;
+    unsigned char cL[37];
+
+    // Get entries and VCOUNT units per jiffy
+    pS = SIOStatsGet(&bC);
+    bP = (bSIOLpf == 0 ? 131 : bSIOLpf);
+
+    // Open window sized to entries
+    bW = WOpen(1, 1, 38, bC + 5, WOFF, WON);
+    WOrn(bW, WPTOP, WPLFT, "SIO Stats");
+    WPrint(bW, 1, 1, WON, "Dv Cm Calls  Bytes  Avg  Max  Err");
+
+    // One line per device/command (33 chars, clamped to fit)
+    for (bL = 0; bL < bC; bL++, pS++) {
+        lA = (pS->iN ? pS->lT / pS->iN / bP : 0UL);
+        sprintf(cL, "%02X %02X %5u %6lu %4lu %4u %4u",
+                pS->bD, pS->bC, pS->iN,
+                (pS->lB > 999999UL ? 999999UL : pS->lB),
+                (lA > 9999UL ? 9999UL : lA),
+                pS->iM / bP,
+                (pS->iE > 9999 ? 9999 : pS->iE));
+        WPrint(bW, 1, 2 + bL, WOFF, cL);
+    }
+    WPrint(bW, WPCNT, bC + 3, WON, " Ok ");
+
+    // Wait for key
+    WaitKCX(WOFF);
+
+    // Close window
+    WClose(bW);
+}
+
+
 // ------------------------------------------------------------
 // Func...: void main(void)
 // Desc...: Main routine
@@ -369,8 +554,8 @@ void main(void)
     // Variables
     byte bW1, bW2;
     byte bC = 1, bD = FALSE;
-    unsigned char *pcM[8] =
-      { " Get Config   ", " Wi-Fi Status ", " Connect Demo ", " Base64 Demo  ", " Hash Demo    ", " About        ", " Exit         " };
+    unsigned char *pcM[10] =
+      { " Get Config   ", " Wi-Fi Status ", " Connect Demo ", " Base64 Demo  ", " Hash Demo    ", " B64 Bench    ", " Hash Bench   ", " SIO Stats    ", " About        ", " Exit         " };
     unsigned char bS = 0;
 
     // Setup screen
@@ -384,13 +569,13 @@ void main(void)
     WPrint(bW1, WPCNT, 1, WOFF, "FujiNet Binding Demo");
 
     // Open menu window
-    bW2 = WOpen(12, 7, 16, 11, WOFF, WON);
+    bW2 = WOpen(12, 5, 16, 13, WOFF, WON);
     WOrn(bW2, WPTOP, WPCNT, "Menu");
 
     // Loop until done (Exit selected)
     while (! bD) {
         // Call menu
-        bC = MenuV(bW2, 1, 2, WOFF, bC, 7, pcM);
+        bC = MenuV(bW2, 1, 2, WOFF, bC, 10, pcM);
 
         // Process choice
         switch (bC) {
@@ -430,12 +615,24 @@ void main(void)
             case 5: TestHash();
                     break;
 
+            // Base64 local vs FujiNet benchmark
+            case 6: BenchB64();
+                    break;
+
+            // Hash local vs FujiNet benchmark
+            case 7: BenchHash();
+                    break;
+
+            // SIO metrics
+            case 8: ShowSIO();
+                    break;
+
             // About box
-            case 6: About();
+            case 9: About();
                     break;
 
             // Exit
-            case 7: bD = TRUE;
+            case 10: bD = TRUE;
                     break;
         }
 
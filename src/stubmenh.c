@@ -22,6 +22,20 @@
 #include "a8libgadg.c"
 #include "a8libmenu.c"
 
+// Pull-down menu items and image caches
+unsigned char *pcF[5] = { " New  ", " Open ", " Save ", " Exit " };
+unsigned char *pcE[4] = { " Cut   ", " Copy  ", " Paste " };
+unsigned char *pcH[3] = { " Index ", " About " };
+unsigned char cCF[8 * 6], cCE[9 * 5], cCH[9 * 4];
+
+// Pull-down descriptors, one per bar item
+td_mpull sMP[3] = {
+    { 4, pcF, NULL, cCF, FALSE, 1 },
+    { 3, pcE, NULL, cCE, FALSE, 1 },
+    { 2, pcH, NULL, cCH, FALSE, 1 }
+};
+
+
 // ------------------------------------------------------------
 // Func...: void main(void)
 // Desc...: Main routine
@@ -29,10 +43,10 @@
 void main(void)
 {
     // Variables
-    byte bW1, bC, bD = FALSE;
+    byte bW1, bC, bB = 1, bD = FALSE;
     unsigned char cL[41];
-    unsigned char *pcM[5] =
-      { " File ", " Edit ", " Help ", " Exit " };
+    unsigned char *pcM[4] =
+      { " File ", " Edit ", " Help " };
 
     // Init Window System
     WInit();
@@ -49,23 +63,16 @@ void main(void)
 
     // Loop until done (Exit selected)
     while (! bD) {
-        // Call menu
-        bC = Menu(bW1, 1, 0, GHORZ, WON, 1, 4, pcM);
-
-        // Process choice
-        switch (bC)
-        {
-            case 1: GAlert("File Menu selected.");
-                    break;
+        // Call menu bar, pull-downs open below it
+        bC = MenuB(bW1, 1, 0, bB, 3, pcM, sMP, &bB);
 
-            case 2: GAlert("Edit Menu selected.");
-                    break;
-
-            case 3: GAlert("Help Menu selected.");
-                    break;
-
-            case 4: bD = TRUE;
-                    break;
+        // Exit on ESC from bar, or File/Exit
+        if ((bC == XESC) || ((bB == 1) && (bC == 4))) {
+            bD = TRUE;
+        }
+        else if (bC != XTAB) {
+            sprintf(cL, "%s /%s selected.", pcM[bB-1], sMP[bB-1].pS[bC-1]);
+            GAlert(cL);
         }
     }
 
@@ -0,0 +1,1076 @@
+// ------------------------------------------------------------
+// Program: sioemu.c
+// Desc...: FujiNet/APE SIO device stand-in for NetSIO
+// Author.: Wade Ripkowski
+// Date...: 2026.11
+// License: GNU General Public License v3.0
+// Notes..: Host (Linux) tool, not built with cc65.
+//            cc -O2 -o sioemu sioemu.c
+//            sioemu [-h host] [-p port] [-l ms] [-b bytes/s]
+//                   [-n pct] [-t pct] [-v]
+//          Connects to a NetSIO hub (an emulator's NetSIO
+//          device, default localhost:9997) as a FujiNet would,
+//          and answers:
+//            $70 status, config, Base64, and hash commands
+//            $71-$78 N1:-N8: open, close, status, read, write,
+//                    translation, channel mode
+//            $45 APE time
+//          N: connections do no networking.  Any URL opens an
+//          echo connection (writes come back as reads), except
+//          N:GEN://<n> which holds n bytes of test data and
+//          reports disconnected once they are read.
+//          -l adds latency before each command completes, -b
+//          limits data frame bandwidth, and -n/-t NAK or drop
+//          a percentage of commands to exercise SIO retries.
+//          Flow control credits are not enforced, and JSON
+//          parse/query is not emulated (command error).
+// ------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+// NetSIO messages
+#define NSDATA   0x01
+#define NSBLOCK  0x02
+#define NSSYNC   0x09
+#define NSCMDOFF 0x10
+#define NSCMDON  0x11
+#define NSCMDSYN 0x18
+#define NSPRCOFF 0x30
+#define NSPRCON  0x31
+#define NSSPEED  0x80
+#define NSSYNRSP 0x81
+#define NSDISC   0xC0
+#define NSCONN   0xC1
+#define NSPINGRQ 0xC2
+#define NSPINGRS 0xC3
+#define NSALIVRQ 0xC4
+#define NSWRESET 0xFE
+#define NSCRESET 0xFF
+
+// Sync response ack types
+#define NSAEMPTY 0
+#define NSAACK   1
+
+// Largest data block per NetSIO packet
+#define NSBLKMAX 512
+
+// SIO bytes
+#define SIOACK 'A'
+#define SIONAK 'N'
+#define SIOCMP 'C'
+#define SIOERR 'E'
+
+// Devices and commands (see a8deffuji*.h, a8defape.h)
+#define FNRAWID  0x70
+#define FNDEVID  0x71
+#define FNUNITS  8
+#define APEDEVID 0x45
+#define APEGTIME 0x93
+
+// Command data directions
+#define DRNONE  0
+#define DRREAD  1
+#define DRWRITE 2
+
+// Largest data frame
+#define DATMAX 65535
+
+// Growable byte buffer
+typedef struct {
+    unsigned char *cB;
+    size_t iN;
+    size_t iZ;
+} td_buf;
+
+// N: unit
+typedef struct {
+    int bO;         // Open
+    int bG;         // Generated data (not echo)
+    int bT;         // Translation mode (kept, not applied)
+    int bM;         // Channel mode
+    td_buf sR;      // Bytes waiting to be read
+} td_unit;
+
+// Options
+static const char *cHost = "localhost";
+static int iPort = 9997;
+static long lLat = 0;
+static long lBw = 0;
+static int iNak = 0;
+static int iDrop = 0;
+static int bVerb = 0;
+
+// NetSIO socket and hub
+static int iSock;
+static struct sockaddr_storage sHub;
+static socklen_t iHubL;
+
+// Command frame being received
+static unsigned char cCmd[5];
+static int iCmdN = 0, bInCmd = 0;
+
+// Write data frame being received, and its command
+static unsigned char cDat[DATMAX + 1];
+static size_t iDatN = 0, iDatZ = 0;
+static unsigned char cPend[5];
+
+// Device state
+static td_buf sB64I[2], sB64O[2];
+static td_buf sHshI;
+static unsigned char cHshO[64];
+static size_t iHshZ = 0;
+static td_unit sUnit[FNUNITS];
+static int bPrc = 0;
+
+
+// ------------------------------------------------------------
+// Func...: void BufAdd(td_buf *pB, const unsigned char *cS, size_t iS)
+// Desc...: Appends bytes to a buffer
+// ------------------------------------------------------------
+void BufAdd(td_buf *pB, const unsigned char *cS, size_t iS)
+{
+    // Grow as needed
+    if (pB->iN + iS > pB->iZ) {
+        pB->iZ = (pB->iN + iS) * 2 + 256;
+        pB->cB = realloc(pB->cB, pB->iZ);
+        if (! pB->cB) {
+            perror("realloc");
+            exit(1);
+        }
+    }
+
+    memcpy(pB->cB + pB->iN, cS, iS);
+    pB->iN += iS;
+}
+
+
+// ------------------------------------------------------------
+// Func...: size_t BufTake(td_buf *pB, unsigned char *cD, size_t iS)
+// Desc...: Removes up to iS bytes from the front of a buffer
+// Return.: # of bytes removed
+// ------------------------------------------------------------
+size_t BufTake(td_buf *pB, unsigned char *cD, size_t iS)
+{
+    if (iS > pB->iN) {
+        iS = pB->iN;
+    }
+
+    memcpy(cD, pB->cB, iS);
+    memmove(pB->cB, pB->cB + iS, pB->iN - iS);
+    pB->iN -= iS;
+
+    return iS;
+}
+
+
+// ------------------------------------------------------------
+// Func...: void Delay(long lU)
+// Desc...: Sleeps lU microseconds
+// ------------------------------------------------------------
+void Delay(long lU)
+{
+    struct timespec sT;
+
+    if (lU > 0) {
+        sT.tv_sec = lU / 1000000;
+        sT.tv_nsec = (lU % 1000000) * 1000;
+        nanosleep(&sT, NULL);
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void Wire(size_t iS)
+// Desc...: Delays for iS bytes at the -b bandwidth
+// ------------------------------------------------------------
+void Wire(size_t iS)
+{
+    if (lBw > 0) {
+        Delay((long) ((double) iS * 1000000.0 / lBw));
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: unsigned char SIOSum(const unsigned char *cB, size_t iS)
+// Desc...: SIO checksum (sum with end around carry)
+// ------------------------------------------------------------
+unsigned char SIOSum(const unsigned char *cB, size_t iS)
+{
+    unsigned int iC = 0;
+
+    while (iS--) {
+        iC += *(cB++);
+        iC = (iC >> 8) + (iC & 0xFF);
+    }
+
+    return iC;
+}
+
+
+// ------------------------------------------------------------
+// Func...: void NSend(const unsigned char *cB, size_t iS)
+// Desc...: Sends a NetSIO message to the hub
+// ------------------------------------------------------------
+void NSend(const unsigned char *cB, size_t iS)
+{
+    if (sendto(iSock, cB, iS, 0, (struct sockaddr *) &sHub, iHubL) < 0) {
+        perror("sendto");
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void NMsg(unsigned char bM)
+// Desc...: Sends a one byte NetSIO message
+// ------------------------------------------------------------
+void NMsg(unsigned char bM)
+{
+    NSend(&bM, 1);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void NSyncRsp(unsigned char bN, unsigned char bT, unsigned char bA, unsigned short iW)
+// Desc...: Answers a sync request
+// Param..: bN = sync number
+//          bT = ack type (NSAEMPTY = not ours/no answer)
+//          bA = ack byte (SIOACK/SIONAK)
+//          iW = size of write data frame to follow (with checksum)
+// ------------------------------------------------------------
+void NSyncRsp(unsigned char bN, unsigned char bT, unsigned char bA, unsigned short iW)
+{
+    unsigned char cM[6];
+
+    cM[0] = NSSYNRSP;
+    cM[1] = bN;
+    cM[2] = bT;
+    cM[3] = bA;
+    cM[4] = iW & 0xFF;
+    cM[5] = iW >> 8;
+    NSend(cM, 6);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void NData(const unsigned char *cB, size_t iS)
+// Desc...: Sends bytes to the Atari
+// ------------------------------------------------------------
+void NData(const unsigned char *cB, size_t iS)
+{
+    unsigned char cM[NSBLKMAX + 1];
+    size_t iL;
+
+    // Split into blocks
+    while (iS > 0) {
+        iL = (iS > NSBLKMAX ? NSBLKMAX : iS);
+        cM[0] = NSBLOCK;
+        memcpy(cM + 1, cB, iL);
+        NSend(cM, iL + 1);
+        cB += iL;
+        iS -= iL;
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void Proceed(void)
+// Desc...: Sets PROCEED while any N: unit has bytes waiting
+// ------------------------------------------------------------
+void Proceed(void)
+{
+    int bP = 0, iL;
+
+    for (iL = 0; iL < FNUNITS; iL++) {
+        if (sUnit[iL].bO && (sUnit[iL].sR.iN > 0)) {
+            bP = 1;
+        }
+    }
+
+    // Send on change only
+    if (bP != bPrc) {
+        NMsg(bP ? NSPRCON : NSPRCOFF);
+        bPrc = bP;
+    }
+}
+
+
+// ------------------------------------------------------------
+// SHA-1, SHA-256, SHA-512 (FujiNet hash compute)
+// ------------------------------------------------------------
+#define ROL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define ROR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static const uint32_t cK256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint64_t cK512[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+
+// ------------------------------------------------------------
+// Func...: size_t Pad(const td_buf *pB, size_t iBlk, unsigned char **pP)
+// Desc...: Builds padded message (big endian bit length)
+// Return.: Padded length (multiple of iBlk), buffer in *pP
+// ------------------------------------------------------------
+size_t Pad(const td_buf *pB, size_t iBlk, unsigned char **pP)
+{
+    size_t iL = iBlk * ((pB->iN + 1 + iBlk / 8 + iBlk - 1) / iBlk);
+    uint64_t lBits = (uint64_t) pB->iN * 8;
+    unsigned char *cP = calloc(iL, 1);
+    int iB;
+
+    if (pB->iN > 0) {
+        memcpy(cP, pB->cB, pB->iN);
+    }
+    cP[pB->iN] = 0x80;
+    for (iB = 0; iB < 8; iB++) {
+        cP[iL - 1 - iB] = lBits >> (iB * 8);
+    }
+
+    *pP = cP;
+    return iL;
+}
+
+
+// ------------------------------------------------------------
+// Func...: size_t HashSha1(const td_buf *pB, unsigned char *cO)
+// Desc...: SHA-1 of buffer
+// ------------------------------------------------------------
+size_t HashSha1(const td_buf *pB, unsigned char *cO)
+{
+    uint32_t lH[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    uint32_t lW[80], lA, lB, lC, lD, lE, lT;
+    unsigned char *cP;
+    size_t iL = Pad(pB, 64, &cP), iO;
+    int iI;
+
+    for (iO = 0; iO < iL; iO += 64) {
+        for (iI = 0; iI < 80; iI++) {
+            lW[iI] = (iI < 16 ? ((uint32_t) cP[iO + iI * 4] << 24) | (cP[iO + iI * 4 + 1] << 16) |
+                                (cP[iO + iI * 4 + 2] << 8) | cP[iO + iI * 4 + 3]
+                              : ROL32(lW[iI - 3] ^ lW[iI - 8] ^ lW[iI - 14] ^ lW[iI - 16], 1));
+        }
+        lA = lH[0]; lB = lH[1]; lC = lH[2]; lD = lH[3]; lE = lH[4];
+        for (iI = 0; iI < 80; iI++) {
+            if (iI < 20) {
+                lT = ((lB & lC) | (~lB & lD)) + 0x5A827999;
+            }
+            else if (iI < 40) {
+                lT = (lB ^ lC ^ lD) + 0x6ED9EBA1;
+            }
+            else if (iI < 60) {
+                lT = ((lB & lC) | (lB & lD) | (lC & lD)) + 0x8F1BBCDC;
+            }
+            else {
+                lT = (lB ^ lC ^ lD) + 0xCA62C1D6;
+            }
+            lT += ROL32(lA, 5) + lE + lW[iI];
+            lE = lD; lD = lC; lC = ROL32(lB, 30); lB = lA; lA = lT;
+        }
+        lH[0] += lA; lH[1] += lB; lH[2] += lC; lH[3] += lD; lH[4] += lE;
+    }
+    free(cP);
+
+    for (iI = 0; iI < 20; iI++) {
+        cO[iI] = lH[iI / 4] >> (24 - (iI % 4) * 8);
+    }
+    return 20;
+}
+
+
+// ------------------------------------------------------------
+// Func...: size_t HashSha256(const td_buf *pB, unsigned char *cO)
+// Desc...: SHA-256 of buffer
+// ------------------------------------------------------------
+size_t HashSha256(const td_buf *pB, unsigned char *cO)
+{
+    uint32_t lH[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    uint32_t lW[64], lV[8], lT1, lT2;
+    unsigned char *cP;
+    size_t iL = Pad(pB, 64, &cP), iO;
+    int iI;
+
+    for (iO = 0; iO < iL; iO += 64) {
+        for (iI = 0; iI < 64; iI++) {
+            if (iI < 16) {
+                lW[iI] = ((uint32_t) cP[iO + iI * 4] << 24) | (cP[iO + iI * 4 + 1] << 16) |
+                         (cP[iO + iI * 4 + 2] << 8) | cP[iO + iI * 4 + 3];
+            }
+            else {
+                lW[iI] = lW[iI - 16] + lW[iI - 7] +
+                         (ROR32(lW[iI - 15], 7) ^ ROR32(lW[iI - 15], 18) ^ (lW[iI - 15] >> 3)) +
+                         (ROR32(lW[iI - 2], 17) ^ ROR32(lW[iI - 2], 19) ^ (lW[iI - 2] >> 10));
+            }
+        }
+        memcpy(lV, lH, sizeof(lH));
+        for (iI = 0; iI < 64; iI++) {
+            lT1 = lV[7] + (ROR32(lV[4], 6) ^ ROR32(lV[4], 11) ^ ROR32(lV[4], 25)) +
+                  ((lV[4] & lV[5]) ^ (~lV[4] & lV[6])) + cK256[iI] + lW[iI];
+            lT2 = (ROR32(lV[0], 2) ^ ROR32(lV[0], 13) ^ ROR32(lV[0], 22)) +
+                  ((lV[0] & lV[1]) ^ (lV[0] & lV[2]) ^ (lV[1] & lV[2]));
+            memmove(lV + 1, lV, 7 * sizeof(uint32_t));
+            lV[4] += lT1;
+            lV[0] = lT1 + lT2;
+        }
+        for (iI = 0; iI < 8; iI++) {
+            lH[iI] += lV[iI];
+        }
+    }
+    free(cP);
+
+    for (iI = 0; iI < 32; iI++) {
+        cO[iI] = lH[iI / 4] >> (24 - (iI % 4) * 8);
+    }
+    return 32;
+}
+
+
+// ------------------------------------------------------------
+// Func...: size_t HashSha512(const td_buf *pB, unsigned char *cO)
+// Desc...: SHA-512 of buffer (bit length kept to 64 bits)
+// ------------------------------------------------------------
+size_t HashSha512(const td_buf *pB, unsigned char *cO)
+{
+    uint64_t lH[8] = { 0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+                       0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+                       0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL };
+    uint64_t lW[80], lV[8], lT1, lT2;
+    unsigned char *cP;
+    size_t iL = Pad(pB, 128, &cP), iO;
+    int iI, iB;
+
+    for (iO = 0; iO < iL; iO += 128) {
+        for (iI = 0; iI < 80; iI++) {
+            if (iI < 16) {
+                lW[iI] = 0;
+                for (iB = 0; iB < 8; iB++) {
+                    lW[iI] = (lW[iI] << 8) | cP[iO + iI * 8 + iB];
+                }
+            }
+            else {
+                lW[iI] = lW[iI - 16] + lW[iI - 7] +
+                         (ROR64(lW[iI - 15], 1) ^ ROR64(lW[iI - 15], 8) ^ (lW[iI - 15] >> 7)) +
+                         (ROR64(lW[iI - 2], 19) ^ ROR64(lW[iI - 2], 61) ^ (lW[iI - 2] >> 6));
+            }
+        }
+        memcpy(lV, lH, sizeof(lH));
+        for (iI = 0; iI < 80; iI++) {
+            lT1 = lV[7] + (ROR64(lV[4], 14) ^ ROR64(lV[4], 18) ^ ROR64(lV[4], 41)) +
+                  ((lV[4] & lV[5]) ^ (~lV[4] & lV[6])) + cK512[iI] + lW[iI];
+            lT2 = (ROR64(lV[0], 28) ^ ROR64(lV[0], 34) ^ ROR64(lV[0], 39)) +
+                  ((lV[0] & lV[1]) ^ (lV[0] & lV[2]) ^ (lV[1] & lV[2]));
+            memmove(lV + 1, lV, 7 * sizeof(uint64_t));
+            lV[4] += lT1;
+            lV[0] = lT1 + lT2;
+        }
+        for (iI = 0; iI < 8; iI++) {
+            lH[iI] += lV[iI];
+        }
+    }
+    free(cP);
+
+    for (iI = 0; iI < 64; iI++) {
+        cO[iI] = lH[iI / 8] >> (56 - (iI % 8) * 8);
+    }
+    return 64;
+}
+
+
+// ------------------------------------------------------------
+// Base64 (FujiNet Base64 compute)
+// ------------------------------------------------------------
+static const char cB64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+
+// ------------------------------------------------------------
+// Func...: void B64Enc(td_buf *pI, td_buf *pO)
+// Desc...: Encodes all of pI onto pO, empties pI
+// ------------------------------------------------------------
+void B64Enc(td_buf *pI, td_buf *pO)
+{
+    unsigned char cQ[4];
+    unsigned int iV;
+    size_t iL;
+
+    for (iL = 0; iL < pI->iN; iL += 3) {
+        iV = pI->cB[iL] << 16;
+        if (iL + 1 < pI->iN) {
+            iV |= pI->cB[iL + 1] << 8;
+        }
+        if (iL + 2 < pI->iN) {
+            iV |= pI->cB[iL + 2];
+        }
+        cQ[0] = cB64[(iV >> 18) & 63];
+        cQ[1] = cB64[(iV >> 12) & 63];
+        cQ[2] = (iL + 1 < pI->iN ? cB64[(iV >> 6) & 63] : '=');
+        cQ[3] = (iL + 2 < pI->iN ? cB64[iV & 63] : '=');
+        BufAdd(pO, cQ, 4);
+    }
+    pI->iN = 0;
+}
+
+
+// ------------------------------------------------------------
+// Func...: void B64Dec(td_buf *pI, td_buf *pO)
+// Desc...: Decodes all of pI onto pO, empties pI
+// Notes..: Skips non Base64 characters, stops at pad.
+// ------------------------------------------------------------
+void B64Dec(td_buf *pI, td_buf *pO)
+{
+    unsigned int iV = 0, iN = 0;
+    unsigned char bC;
+    const char *pC;
+    size_t iL;
+
+    for (iL = 0; iL < pI->iN; iL++) {
+        if (pI->cB[iL] == '=') {
+            break;
+        }
+        pC = (pI->cB[iL] ? strchr(cB64, pI->cB[iL]) : NULL);
+        if (! pC) {
+            continue;
+        }
+        iV = (iV << 6) | (pC - cB64);
+        if (++iN == 4) {
+            bC = iV >> 16; BufAdd(pO, &bC, 1);
+            bC = iV >> 8;  BufAdd(pO, &bC, 1);
+            bC = iV;       BufAdd(pO, &bC, 1);
+            iV = iN = 0;
+        }
+    }
+
+    // Partial last group
+    if (iN >= 2) {
+        iV <<= 6 * (4 - iN);
+        bC = iV >> 16; BufAdd(pO, &bC, 1);
+        if (iN == 3) {
+            bC = iV >> 8; BufAdd(pO, &bC, 1);
+        }
+    }
+    pI->iN = 0;
+}
+
+
+// ------------------------------------------------------------
+// Func...: int CmdSpec(unsigned char *cF, size_t *pS)
+// Desc...: Looks up a command's data direction and size
+// Param..: cF = command frame
+//          pS = data frame size (out)
+// Return.: DRNONE/DRREAD/DRWRITE, -1 if not a device here
+//          -2 if unknown command
+// ------------------------------------------------------------
+int CmdSpec(unsigned char *cF, size_t *pS)
+{
+    unsigned short iA = cF[2] | (cF[3] << 8);
+    *pS = 0;
+
+    // FujiNet raw device
+    if (cF[0] == FNRAWID) {
+        switch (cF[1]) {
+            case 0xFA: *pS = 1; return DRREAD;
+            case 0xE8: *pS = 140; return DRREAD;
+            case 0xD0:
+            case 0xCC:
+            case 0xC8: *pS = iA; return DRWRITE;
+            case 0xCF:
+            case 0xCB:
+            case 0xC7: return DRNONE;
+            case 0xCE:
+            case 0xCA: *pS = 4; return DRREAD;
+            case 0xCD:
+            case 0xC9: *pS = iA; return DRREAD;
+            case 0xC5: *pS = (cF[2] ? iHshZ * 2 : iHshZ); return DRREAD;
+        }
+        return -2;
+    }
+
+    // N1: to N8:
+    if ((cF[0] >= FNDEVID) && (cF[0] < FNDEVID + FNUNITS)) {
+        switch (cF[1]) {
+            case 'O':
+            case 'Q': *pS = 256; return DRWRITE;
+            case 'W': *pS = iA; return DRWRITE;
+            case 'R': *pS = iA; return DRREAD;
+            case 'S': *pS = 4; return DRREAD;
+            case 'C':
+            case 'T':
+            case 'M':
+            case 'P':
+            case 'Z':
+            case 0xFC: return DRNONE;
+        }
+        return -2;
+    }
+
+    // APE time
+    if (cF[0] == APEDEVID) {
+        if (cF[1] == APEGTIME) {
+            *pS = 6;
+            return DRREAD;
+        }
+        return -2;
+    }
+
+    return -1;
+}
+
+
+// ------------------------------------------------------------
+// Func...: int CmdRaw(unsigned char *cF, unsigned char *cD, size_t iS)
+// Desc...: Runs a $70 command
+// Param..: cF = command frame
+//          cD = data frame (in for write, out for read)
+//          iS = data frame size
+// Return.: 1 = complete, 0 = error
+// ------------------------------------------------------------
+int CmdRaw(unsigned char *cF, unsigned char *cD, size_t iS)
+{
+    static const char cHex[] = "0123456789abcdef";
+    int iE, iL;
+    uint32_t lL;
+
+    // Base64 encode (0) or decode (1) set
+    iE = ((cF[1] >= 0xCD) && (cF[1] <= 0xD0) ? 0 : 1);
+
+    switch (cF[1]) {
+        // WiFi status: active
+        case 0xFA: cD[0] = 3;
+                   return 1;
+
+        // Adapter config
+        case 0xE8: memset(cD, 0, iS);
+                   strcpy((char *) cD, "SIOEMU");
+                   strcpy((char *) cD + 33, "sioemu");
+                   cD[97] = 127;
+                   cD[100] = 1;
+                   strcpy((char *) cD + 125, "sioemu 1.0");
+                   return 1;
+
+        // Base64 input, compute, length, output
+        case 0xD0:
+        case 0xCC: BufAdd(&sB64I[iE], cD, iS);
+                   return 1;
+        case 0xCF: B64Enc(&sB64I[0], &sB64O[0]);
+                   return 1;
+        case 0xCB: B64Dec(&sB64I[1], &sB64O[1]);
+                   return 1;
+        case 0xCE:
+        case 0xCA: lL = sB64O[iE].iN;
+                   cD[0] = lL; cD[1] = lL >> 8; cD[2] = lL >> 16; cD[3] = lL >> 24;
+                   return 1;
+        case 0xCD:
+        case 0xC9: memset(cD, 0, iS);
+                   return (BufTake(&sB64O[iE], cD, iS) == iS);
+
+        // Hash input, compute (aux1 = type), output (aux1 = hex)
+        case 0xC8: BufAdd(&sHshI, cD, iS);
+                   return 1;
+        case 0xC7: switch (cF[2]) {
+                       case 1: iHshZ = HashSha1(&sHshI, cHshO); break;
+                       case 2: iHshZ = HashSha256(&sHshI, cHshO); break;
+                       case 3: iHshZ = HashSha512(&sHshI, cHshO); break;
+                       default: iHshZ = 0;
+                   }
+                   sHshI.iN = 0;
+                   return (iHshZ > 0);
+        case 0xC5: for (iL = 0; iL < (int) iHshZ; iL++) {
+                       if (cF[2]) {
+                           cD[iL * 2] = cHex[cHshO[iL] >> 4];
+                           cD[iL * 2 + 1] = cHex[cHshO[iL] & 0x0F];
+                       }
+                       else {
+                           cD[iL] = cHshO[iL];
+                       }
+                   }
+                   return 1;
+    }
+
+    return 0;
+}
+
+
+// ------------------------------------------------------------
+// Func...: int CmdNet(unsigned char *cF, unsigned char *cD, size_t iS)
+// Desc...: Runs an N: command
+// Param..: cF = command frame
+//          cD = data frame (in for write, out for read)
+//          iS = data frame size
+// Return.: 1 = complete, 0 = error
+// ------------------------------------------------------------
+int CmdNet(unsigned char *cF, unsigned char *cD, size_t iS)
+{
+    td_unit *pU = &sUnit[cF[0] - FNDEVID];
+    unsigned char cG[256];
+    char *pG;
+    long lN, lL;
+    size_t iR, iG;
+
+    switch (cF[1]) {
+        // Open: echo, or N:GEN://<n> test data
+        case 'O': cD[255] = 0;
+                  pU->sR.iN = 0;
+                  pU->bO = 1;
+                  pU->bT = cF[3];
+                  pU->bM = 0;
+                  pG = strstr((char *) cD, "GEN://");
+                  pU->bG = (pG != NULL);
+                  if (pG) {
+                      lN = atol(pG + 6);
+                      for (lL = 0; lL < lN; lL += iR) {
+                          iR = (lN - lL > 256 ? 256 : lN - lL);
+                          for (iG = 0; iG < iR; iG++) {
+                              cG[iG] = (lL + iG) & 0xFF;
+                          }
+                          BufAdd(&pU->sR, cG, iR);
+                      }
+                  }
+                  return 1;
+
+        // Close
+        case 'C': pU->bO = 0;
+                  pU->sR.iN = 0;
+                  return 1;
+
+        // Status: waiting, connected, error
+        case 'S': lN = (pU->sR.iN > 65535 ? 65535 : pU->sR.iN);
+                  cD[0] = lN;
+                  cD[1] = lN >> 8;
+                  cD[2] = pU->bO && (pU->sR.iN > 0 || ! pU->bG);
+                  cD[3] = (cD[2] || pU->sR.iN ? 1 : 136);
+                  return pU->bO;
+
+        // Read: error if more than waiting
+        case 'R': memset(cD, 0, iS);
+                  return pU->bO && (BufTake(&pU->sR, cD, iS) == iS);
+
+        // Write: echo back unless test data
+        case 'W': if (pU->bO && ! pU->bG) {
+                      BufAdd(&pU->sR, cD, iS);
+                  }
+                  return pU->bO;
+
+        // Translation, HTTP channel mode, timer
+        case 'T':
+        case 'M':
+        case 'Z': return pU->bO;
+
+        // Channel mode (aux2)
+        case 0xFC: pU->bM = cF[3];
+                   return pU->bO;
+    }
+
+    // JSON parse/query not emulated
+    return 0;
+}
+
+
+// ------------------------------------------------------------
+// Func...: int CmdApe(unsigned char *cF, unsigned char *cD, size_t iS)
+// Desc...: Runs an APE time command (DMYHMS, year - 2000)
+// ------------------------------------------------------------
+int CmdApe(unsigned char *cF, unsigned char *cD, size_t iS)
+{
+    time_t lT = time(NULL);
+    struct tm *pT = localtime(&lT);
+
+    (void) cF;
+    (void) iS;
+    cD[0] = pT->tm_mday;
+    cD[1] = pT->tm_mon + 1;
+    cD[2] = pT->tm_year - 100;
+    cD[3] = pT->tm_hour;
+    cD[4] = pT->tm_min;
+    cD[5] = pT->tm_sec;
+
+    return 1;
+}
+
+
+// ------------------------------------------------------------
+// Func...: void CmdRun(unsigned char *cF, unsigned char *cD, size_t iS, int iD)
+// Desc...: Runs a command and sends completion (and data)
+// Param..: cF = command frame
+//          cD = data frame
+//          iS = data frame size
+//          iD = direction
+// ------------------------------------------------------------
+void CmdRun(unsigned char *cF, unsigned char *cD, size_t iS, int iD)
+{
+    int bOk;
+
+    if (cF[0] == FNRAWID) {
+        bOk = CmdRaw(cF, cD, iS);
+    }
+    else if (cF[0] == APEDEVID) {
+        bOk = CmdApe(cF, cD, iS);
+    }
+    else {
+        bOk = CmdNet(cF, cD, iS);
+    }
+
+    if (bVerb) {
+        fprintf(stderr, "dev $%02X cmd $%02X aux $%02X%02X %5zu bytes %s\n",
+                cF[0], cF[1], cF[3], cF[2], iS, (bOk ? "C" : "E"));
+    }
+
+    // Device time, then complete (data frame for reads)
+    Delay(lLat);
+    if (iD == DRREAD) {
+        Wire(iS + 1);
+        memmove(cD + 1, cD, iS);
+        cD[0] = (bOk ? SIOCMP : SIOERR);
+        cD[iS + 1] = SIOSum(cD + 1, iS);
+        NData(cD, iS + 2);
+    }
+    else {
+        cD[0] = (bOk ? SIOCMP : SIOERR);
+        NData(cD, 1);
+    }
+
+    Proceed();
+}
+
+
+// ------------------------------------------------------------
+// Func...: void CmdFrame(unsigned char bN)
+// Desc...: Handles a complete command frame
+// Param..: bN = sync number
+// ------------------------------------------------------------
+void CmdFrame(unsigned char bN)
+{
+    static unsigned char cR[DATMAX + 2];
+    size_t iS;
+    int iD;
+
+    // Bad frame, or not one of ours: no answer
+    iD = ((iCmdN == 5) && (SIOSum(cCmd, 4) == cCmd[4]) ? CmdSpec(cCmd, &iS) : -1);
+    if ((iD == -1) || (rand() % 100 < iDrop)) {
+        NSyncRsp(bN, NSAEMPTY, 0, 0);
+        return;
+    }
+
+    // Unknown command or injected fault: NAK
+    if ((iD == -2) || (iS >= DATMAX) || (rand() % 100 < iNak)) {
+        NSyncRsp(bN, NSAACK, SIONAK, 0);
+        return;
+    }
+
+    // Write: wait for data frame
+    if (iD == DRWRITE) {
+        memcpy(cPend, cCmd, 5);
+        iDatN = 0;
+        iDatZ = iS + 1;
+        NSyncRsp(bN, NSAACK, SIOACK, iDatZ);
+        return;
+    }
+
+    NSyncRsp(bN, NSAACK, SIOACK, 0);
+    CmdRun(cCmd, cR, iS, iD);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void DataFrame(unsigned char bN)
+// Desc...: Handles a complete write data frame
+// Param..: bN = sync number
+// ------------------------------------------------------------
+void DataFrame(unsigned char bN)
+{
+    static unsigned char cR[DATMAX + 2];
+    size_t iS = iDatZ - 1;
+
+    Wire(iDatZ);
+    iDatZ = 0;
+
+    // Check data frame
+    if ((iDatN != iS + 1) || (SIOSum(cDat, iS) != cDat[iS])) {
+        NSyncRsp(bN, NSAACK, SIONAK, 0);
+        return;
+    }
+
+    NSyncRsp(bN, NSAACK, SIOACK, 0);
+    memcpy(cR, cDat, iS);
+    CmdRun(cPend, cR, iS, DRWRITE);
+}
+
+
+// ------------------------------------------------------------
+// Func...: void Feed(const unsigned char *cB, size_t iS)
+// Desc...: Takes bytes from the Atari
+// ------------------------------------------------------------
+void Feed(const unsigned char *cB, size_t iS)
+{
+    while (iS--) {
+        if (bInCmd) {
+            if (iCmdN < 5) {
+                cCmd[iCmdN] = *cB;
+            }
+            iCmdN++;
+        }
+        else if (iDatZ && (iDatN < iDatZ)) {
+            cDat[iDatN++] = *cB;
+        }
+        cB++;
+    }
+}
+
+
+// ------------------------------------------------------------
+// Func...: void Reset(void)
+// Desc...: Clears all device state
+// ------------------------------------------------------------
+void Reset(void)
+{
+    int iL;
+
+    sB64I[0].iN = sB64I[1].iN = sB64O[0].iN = sB64O[1].iN = 0;
+    sHshI.iN = 0;
+    iHshZ = 0;
+    for (iL = 0; iL < FNUNITS; iL++) {
+        sUnit[iL].bO = 0;
+        sUnit[iL].sR.iN = 0;
+    }
+    bInCmd = 0;
+    iDatZ = 0;
+    Proceed();
+}
+
+
+// ------------------------------------------------------------
+// Func...: int main(int argc, char *argv[])
+// Desc...: Main routine
+// ------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    static unsigned char cM[NSBLKMAX * 4];
+    struct addrinfo sA, *pA;
+    struct pollfd sP;
+    char cPort[8];
+    ssize_t iR;
+    int iO;
+
+    // Options
+    while ((iO = getopt(argc, argv, "h:p:l:b:n:t:v")) != -1) {
+        switch (iO) {
+            case 'h': cHost = optarg; break;
+            case 'p': iPort = atoi(optarg); break;
+            case 'l': lLat = atol(optarg) * 1000; break;
+            case 'b': lBw = atol(optarg); break;
+            case 'n': iNak = atoi(optarg); break;
+            case 't': iDrop = atoi(optarg); break;
+            case 'v': bVerb = 1; break;
+            default:  fprintf(stderr, "usage: %s [-h host] [-p port] [-l ms] [-b bytes/s] [-n pct] [-t pct] [-v]\n", argv[0]);
+                      return 1;
+        }
+    }
+
+    // Find hub
+    memset(&sA, 0, sizeof(sA));
+    sA.ai_family = AF_UNSPEC;
+    sA.ai_socktype = SOCK_DGRAM;
+    snprintf(cPort, sizeof(cPort), "%d", iPort);
+    if (getaddrinfo(cHost, cPort, &sA, &pA) != 0) {
+        fprintf(stderr, "sioemu: cannot resolve %s\n", cHost);
+        return 1;
+    }
+    iSock = socket(pA->ai_family, SOCK_DGRAM, 0);
+    if (iSock < 0) {
+        perror("socket");
+        return 1;
+    }
+    memcpy(&sHub, pA->ai_addr, pA->ai_addrlen);
+    iHubL = pA->ai_addrlen;
+    freeaddrinfo(pA);
+
+    // Announce device
+    NMsg(NSCONN);
+    fprintf(stderr, "sioemu: NetSIO hub %s:%d, latency %ld ms, bandwidth %ld B/s\n",
+            cHost, iPort, lLat / 1000, lBw);
+
+    sP.fd = iSock;
+    sP.events = POLLIN;
+    while (1) {
+        // Keep hub aware of device when idle
+        if (poll(&sP, 1, 1000) == 0) {
+            NMsg(NSALIVRQ);
+            continue;
+        }
+
+        iR = recv(iSock, cM, sizeof(cM), 0);
+        if (iR < 1) {
+            continue;
+        }
+
+        switch (cM[0]) {
+            case NSCMDON:  bInCmd = 1;
+                           iCmdN = 0;
+                           iDatZ = 0;
+                           break;
+            case NSCMDOFF: bInCmd = 0;
+                           break;
+            case NSCMDSYN: bInCmd = 0;
+                           if (iR >= 2) {
+                               CmdFrame(cM[1]);
+                           }
+                           break;
+            case NSDATA:   Feed(cM + 1, (iR >= 2 ? 1 : 0));
+                           break;
+            case NSBLOCK:  Feed(cM + 1, iR - 1);
+                           break;
+            case NSSYNC:   if (iR >= 3) {
+                               Feed(cM + 1, 1);
+                               if (iDatZ) {
+                                   DataFrame(cM[2]);
+                               }
+                           }
+                           break;
+            case NSPINGRQ: NMsg(NSPINGRS);
+                           break;
+            case NSWRESET:
+            case NSCRESET: Reset();
+                           break;
+        }
+    }
+
+    return 0;
+}